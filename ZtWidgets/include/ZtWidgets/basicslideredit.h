@@ -0,0 +1,329 @@
+/*
+ * Copyright (c) 2021 Victor Wåhlström
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ * claim that you wrote the original software. If you use this software
+ * in a product, an acknowledgment in the product documentation would be
+ * appreciated but is not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source
+ */
+
+
+#ifndef BASICSLIDEREDIT_H
+#define BASICSLIDEREDIT_H
+
+#include "slideredit.h"
+
+#include <QLocale>
+
+#include <cmath>
+#include <limits>
+
+/**
+ * @brief A fixed-point number with a compile time number of decimals
+ *
+ * Stored as an integer scaled by 10^Decimals, so values such as 0.1 are represented exactly. The scaled integer must
+ * fit in a qint64, which limits the magnitude of values to about 9.2e18 / 10^Decimals, e.g. 9.2e15 with 3 decimals
+ * and 9200 with 15 decimals. Values outside that range are saturated when converted from floating point.
+ */
+template<int Decimals>
+struct FixedPoint
+{
+    static_assert(Decimals >= 0 && Decimals <= 15, "FixedPoint supports between 0 and 15 decimals");
+
+    /**
+     * @brief The factor values are scaled by
+     */
+    static constexpr qint64 scale() { return scaleOf(Decimals); }
+
+    /**
+     * @brief Construct a fixed-point number from its scaled integer representation
+     */
+    static constexpr FixedPoint fromRaw(qint64 raw) { return FixedPoint{raw}; }
+
+    /**
+     * @brief Construct a fixed-point number from the closest representable value
+     */
+    static FixedPoint fromReal(qreal value) { return fromRaw(qRound64(saturate(value * scale()))); }
+
+    /**
+     * @brief Construct a fixed-point number from the closest representable value not greater than value
+     */
+    static FixedPoint floor(qreal value) { return fromRaw(static_cast<qint64>(std::floor(saturate(value * scale())))); }
+
+    /**
+     * @brief Construct a fixed-point number from the closest representable value not less than value
+     */
+    static FixedPoint ceil(qreal value) { return fromRaw(static_cast<qint64>(std::ceil(saturate(value * scale())))); }
+
+    /**
+     * @brief Convert to a floating point value
+     */
+    constexpr qreal toReal() const { return static_cast<qreal>(raw) / scale(); }
+
+    constexpr bool operator==(const FixedPoint& other) const { return raw == other.raw; }
+    constexpr bool operator!=(const FixedPoint& other) const { return raw != other.raw; }
+    constexpr bool operator<(const FixedPoint& other) const { return raw < other.raw; }
+
+    qint64 raw;
+
+  private:
+    static constexpr qint64 scaleOf(int decimals) { return decimals == 0 ? 1 : 10 * scaleOf(decimals - 1); }
+
+    // converting a floating point value outside the range of qint64 is undefined, so stay just inside it. NaN is
+    // saturated as well.
+    static qreal saturate(qreal scaled) { return qBound<qreal>(-9.2e18, scaled, 9.2e18); }
+};
+
+/**
+ * @brief Conversion, formatting and parsing of the value type of a BasicSliderEdit
+ *
+ * Specialized for int, float, double and FixedPoint. Specialize this to use BasicSliderEdit with other types.
+ */
+template<typename T>
+struct SliderValueTraits;
+
+/**
+ * @brief Integer values. Always displayed without decimals and parsed as integers.
+ */
+template<>
+struct SliderValueTraits<int>
+{
+    static int fromReal(qreal value)
+    {
+        return static_cast<int>(qBound<qint64>(std::numeric_limits<int>::min(),
+                                               qRound64(value),
+                                               std::numeric_limits<int>::max()));
+    }
+
+    static int floor(qreal value) { return fromReal(std::floor(value)); }
+    static int ceil(qreal value) { return fromReal(std::ceil(value)); }
+    static qreal toReal(int value) { return value; }
+    static quint32 decimals(quint32) { return 0; }
+
+    static bool parse(const QString& text, const QLocale* locale, int* value)
+    {
+        bool valid;
+        *value = locale ? locale->toInt(text, &valid) : text.toInt(&valid);
+        return valid;
+    }
+};
+
+/**
+ * @brief Single precision values. Displayed with at most 7 decimals.
+ */
+template<>
+struct SliderValueTraits<float>
+{
+    static float fromReal(qreal value) { return static_cast<float>(value); }
+
+    static float floor(qreal value)
+    {
+        const float f = fromReal(value);
+        return f > value ? std::nextafter(f, -std::numeric_limits<float>::infinity()) : f;
+    }
+
+    static float ceil(qreal value)
+    {
+        const float f = fromReal(value);
+        return f < value ? std::nextafter(f, std::numeric_limits<float>::infinity()) : f;
+    }
+
+    static qreal toReal(float value) { return static_cast<qreal>(value); }
+    static quint32 decimals(quint32 precision) { return qMin(precision, 7u); }
+
+    static bool parse(const QString& text, const QLocale* locale, float* value)
+    {
+        bool valid;
+        *value = locale ? locale->toFloat(text, &valid) : text.toFloat(&valid);
+        return valid;
+    }
+};
+
+/**
+ * @brief Double precision values. Behaves exactly like SliderEdit.
+ */
+template<>
+struct SliderValueTraits<double>
+{
+    static double fromReal(qreal value) { return value; }
+    static double floor(qreal value) { return value; }
+    static double ceil(qreal value) { return value; }
+    static qreal toReal(double value) { return value; }
+    static quint32 decimals(quint32 precision) { return precision; }
+
+    static bool parse(const QString& text, const QLocale* locale, double* value)
+    {
+        bool valid;
+        *value = locale ? locale->toDouble(text, &valid) : text.toDouble(&valid);
+        return valid;
+    }
+};
+
+/**
+ * @brief Fixed-point values. Always displayed with Decimals decimals.
+ */
+template<int Decimals>
+struct SliderValueTraits<FixedPoint<Decimals>>
+{
+    static FixedPoint<Decimals> fromReal(qreal value) { return FixedPoint<Decimals>::fromReal(value); }
+    static FixedPoint<Decimals> floor(qreal value) { return FixedPoint<Decimals>::floor(value); }
+    static FixedPoint<Decimals> ceil(qreal value) { return FixedPoint<Decimals>::ceil(value); }
+    static qreal toReal(FixedPoint<Decimals> value) { return value.toReal(); }
+    static quint32 decimals(quint32) { return Decimals; }
+
+    static bool parse(const QString& text, const QLocale* locale, FixedPoint<Decimals>* value)
+    {
+        bool valid;
+        const double parsed = locale ? locale->toDouble(text, &valid) : text.toDouble(&valid);
+        *value              = fromReal(parsed);
+        return valid;
+    }
+};
+
+/**
+ * @brief A SliderEdit holding values of type T
+ *
+ * Values are restricted to what T can represent as soon as they are set, typed or picked, so an integer slider only
+ * ever holds and reports whole numbers. Values inside the range are kept inside it, even if its bounds can not be
+ * represented by T, as long as the range holds at least one such value. Formatting, parsing and rounding are resolved
+ * at compile time through SliderValueTraits.
+ *
+ * The value is still stored as a qreal, and the qreal based properties and signals of SliderEdit remain available.
+ * The typed accessors and the onValueChanged()/onValueChanging() connection helpers convert to and from T. For int,
+ * float and FixedPoint values within the documented range of FixedPoint, converting a held value to T and back yields
+ * the same value. Typed values still pass through a qreal on their way in and out.
+ *
+ * @note Qt's meta-object compiler does not support class templates, so this class can not declare signals of its
+ * own. The typed connection helpers fill that role.
+ */
+template<typename T>
+class BasicSliderEdit : public SliderEdit
+{
+  public:
+    typedef T ValueType;
+    typedef SliderValueTraits<T> Traits;
+
+    /**
+     * @brief Construct an instance of BasicSliderEdit
+     * @param parent Parent widget
+     * @param f Window flags
+     */
+    explicit BasicSliderEdit(QWidget* parent = nullptr, Qt::WindowFlags f = Qt::WindowFlags())
+        : SliderEdit(parent, f)
+    {}
+
+    /**
+     * @brief Get the current value
+     */
+    T typedValue() const { return Traits::fromReal(value()); }
+
+    /**
+     * @brief Set the current value. Will emit valueChanged.
+     */
+    void setTypedValue(T value) { setValue(Traits::toReal(value)); }
+
+    /**
+     * @brief Set the range of the slider
+     */
+    void setTypedRange(T minimum, T maximum) { setRange(Traits::toReal(minimum), Traits::toReal(maximum)); }
+
+    /**
+     * @brief Get the minimum value
+     */
+    T typedMinimum() const { return Traits::fromReal(minimum()); }
+
+    /**
+     * @brief Get the maximum value
+     */
+    T typedMaximum() const { return Traits::fromReal(maximum()); }
+
+    /**
+     * @brief Connect a functor taking a T to valueChanged
+     * @param context The connection is removed when this object is destroyed
+     * @param functor Functor called with the new value
+     */
+    template<typename Functor>
+    QMetaObject::Connection onValueChanged(const QObject* context, Functor functor)
+    {
+        return connect(this, &SliderEdit::valueChanged, context, [functor](qreal v) { functor(Traits::fromReal(v)); });
+    }
+
+    /**
+     * @brief Connect a functor taking a T to valueChanging
+     * @param context The connection is removed when this object is destroyed
+     * @param functor Functor called with the new value
+     */
+    template<typename Functor>
+    QMetaObject::Connection onValueChanging(const QObject* context, Functor functor)
+    {
+        return connect(this, &SliderEdit::valueChanging, context, [functor](qreal v) { functor(Traits::fromReal(v)); });
+    }
+
+  protected:
+    /**
+     * @brief Overridden from SliderEdit
+     */
+    qreal normalizeValue(qreal value) const override
+    {
+        const qreal normalized = SliderEdit::normalizeValue(value);
+        qreal result           = Traits::toReal(Traits::fromReal(normalized));
+
+        // rounding to T may leave the range if its bounds are not representable, e.g. 10.5 for an IntSliderEdit with a
+        // range of 0.5 to 10.5. Round towards the inside of the range instead.
+        if (normalized >= minimum() && result < minimum())
+            result = Traits::toReal(Traits::ceil(minimum()));
+        if (normalized <= maximum() && result > maximum())
+            result = Traits::toReal(Traits::floor(maximum()));
+
+        return result;
+    }
+
+    /**
+     * @brief Overridden from SliderEdit
+     */
+    quint32 valueDecimals() const override { return Traits::decimals(precision()); }
+
+    /**
+     * @brief Overridden from SliderEdit
+     */
+    bool parseValue(const QString& text, qreal* value) const override
+    {
+        const QLocale widget_locale = locale();
+        T parsed;
+        if (!Traits::parse(text, localizedNumbers() ? &widget_locale : nullptr, &parsed))
+            return false;
+
+        *value = Traits::toReal(parsed);
+        return true;
+    }
+};
+
+/**
+ * @brief A slider holding integer values
+ */
+typedef BasicSliderEdit<int> IntSliderEdit;
+
+/**
+ * @brief A slider holding single precision values
+ */
+typedef BasicSliderEdit<float> FloatSliderEdit;
+
+/**
+ * @brief A slider holding double precision values
+ */
+typedef BasicSliderEdit<double> DoubleSliderEdit;
+
+#endif // BASICSLIDEREDIT_H
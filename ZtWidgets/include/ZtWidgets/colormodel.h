@@ -0,0 +1,116 @@
+/*
+ * Copyright (c) 2021 Victor Wåhlström
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ * claim that you wrote the original software. If you use this software
+ * in a product, an acknowledgment in the product documentation would be
+ * appreciated but is not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source
+ */
+
+#ifndef COLORMODEL_H
+#define COLORMODEL_H
+
+#include "ztwidgets_global.h"
+
+#include <QColor>
+#include <QObject>
+
+class ColorModelPrivate;
+
+/**
+ * @brief A shared color value that any number of color widgets can bind to
+ *
+ * Widgets bound to the same model stay in sync without being connected to each other. Each change to the model
+ * results in exactly one notification, which bound widgets use to refresh themselves. Widgets that are not visible
+ * defer the refresh until they are shown again, reading the current value from the model at that point.
+ *
+ * Every change increments version(), which allows views to cheaply determine whether they are up to date.
+ */
+class ZTWIDGETS_EXPORT ColorModel : public QObject
+{
+    Q_OBJECT
+
+    Q_DISABLE_COPY(ColorModel)
+
+    /**
+     * @brief This property holds the color of the model
+     */
+    Q_PROPERTY(QColor color READ color WRITE setColor NOTIFY colorChanged)
+
+  public:
+    /**
+     * @brief Construct an instance of ColorModel
+     * @param parent Parent object
+     */
+    explicit ColorModel(QObject* parent = nullptr);
+
+    /**
+     * @brief Construct an instance of ColorModel with an initial color
+     * @param color Initial color
+     * @param parent Parent object
+     */
+    explicit ColorModel(const QColor& color, QObject* parent = nullptr);
+
+    virtual ~ColorModel();
+
+    /**
+     * @brief Get the current color
+     * @return The current color of the model
+     */
+    const QColor& color() const;
+
+    /**
+     * @brief Get the current version of the model
+     * @return A counter which is incremented every time the color changes
+     */
+    quint64 version() const;
+
+    /**
+     * @brief Set color
+     * @param color The new color
+     *
+     * Will emit a colorChanged signal if the color changes.
+     */
+    void setColor(const QColor& color);
+
+    /**
+     * @brief Set an intermediate color, e.g. while a slider is being dragged
+     * @param color The new color
+     *
+     * Will emit a colorChanging signal if the color changes.
+     */
+    void setChangingColor(const QColor& color);
+
+  Q_SIGNALS:
+    /**
+     * @param color The new color
+     *
+     * Emitted when the color has changed.
+     */
+    void colorChanged(const QColor& color);
+
+    /**
+     * @param color The new color
+     *
+     * Emitted while the color is being changed.
+     */
+    void colorChanging(const QColor& color);
+
+  private:
+    ColorModelPrivate* const m_Impl;
+};
+
+#endif // COLORMODEL_H
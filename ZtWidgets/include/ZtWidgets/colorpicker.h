@@ -25,15 +25,26 @@
 
 #include "ztwidgets_global.h"
 
+#include <QColor>
+#include <QFont>
+#include <QPalette>
 #include <QWidget>
 
+class ColorModel;
 class ColorPickerPrivate;
+class ColorPreviewChannel;
+class QPainter;
+struct ColorSwatchStyleOption;
+struct ColorWheelStyleOption;
 
 /**
  * @brief A compact color picker widget
  *
  * A compact color picker widget with a hue and saturation wheel.
  * Additional sliders for value, red, green, blue and alpha channels.
+ *
+ * Colors can be dropped onto the picker or pasted into it as hex values (\#RGB, \#RRGGBB or \#AARRGGBB),
+ * CSS rgb()/hsl() notation, or tuples of floating point values on the form (r, g, b, a).
  */
 class ZTWIDGETS_EXPORT ColorPicker : public QWidget
 {
@@ -51,6 +62,21 @@ class ZTWIDGETS_EXPORT ColorPicker : public QWidget
      */
     Q_PROPERTY(EditType editType READ editType WRITE setEditType)
 
+    /**
+     * @brief This property controls how often colorChanging is emitted during an interaction
+     */
+    Q_PROPERTY(TrackingPolicy trackingPolicy READ trackingPolicy WRITE setTrackingPolicy)
+
+    /**
+     * @brief This property holds the interval, in milliseconds, used by time based tracking policies
+     */
+    Q_PROPERTY(int trackingInterval READ trackingInterval WRITE setTrackingInterval)
+
+    /**
+     * @brief This property controls whether the widget is drawn and edited without child widgets
+     */
+    Q_PROPERTY(bool lightweight READ lightweight WRITE setLightweight)
+
   public:
     /**
      * @brief Supported edit types. These are used for display and UI.
@@ -63,6 +89,21 @@ class ZTWIDGETS_EXPORT ColorPicker : public QWidget
 
     Q_ENUM(EditType)
 
+    /**
+     * @brief Determines when colorChanging is emitted while the color is being changed
+     *
+     * colorChanged is always emitted once the interaction ends, regardless of the policy.
+     */
+    enum TrackingPolicy
+    {
+        TrackAlways    = 0, ///< Emit colorChanging for every change
+        TrackThrottled = 1, ///< Emit colorChanging at most once per trackingInterval()
+        TrackOnIdle    = 2, ///< Emit colorChanging once the color has not changed for trackingInterval()
+        TrackOnRelease = 3, ///< Never emit colorChanging
+    };
+
+    Q_ENUM(TrackingPolicy)
+
     /**
      * @brief Construct an instance of ColorPicker
      * @param parent Parent widget
@@ -86,9 +127,49 @@ class ZTWIDGETS_EXPORT ColorPicker : public QWidget
      * @param color The new color
      *
      * Set the color this widget represents. Will emit a colorChanged signal if the color changes.
+     * If the widget is bound to a model, the model is updated as well.
      */
     void setColor(const QColor& color);
 
+    /**
+     * @brief Get color
+     * @return The color this widget represents
+     */
+    QColor color() const;
+
+    /**
+     * @brief Bind the widget to a shared color model
+     * @param model The model to bind to, or nullptr to unbind
+     *
+     * Changes made through the widget are written to the model, and changes to the model are reflected by the widget.
+     * Any number of widgets can be bound to the same model. The model is not owned by the widget.
+     *
+     * @note The colorChanged and colorChanging signals of this widget are only emitted for changes made through this
+     * widget. Connect to the model to be notified of all changes.
+     */
+    void setModel(ColorModel* model);
+
+    /**
+     * @brief Get the model this widget is bound to
+     * @return The bound model, or nullptr if the widget is not bound to a model
+     */
+    ColorModel* model() const;
+
+    /**
+     * @brief Deliver intermediate colors to an asynchronous preview channel
+     * @param channel The channel to post to, or nullptr to disable asynchronous previews
+     *
+     * Every intermediate color is posted to the channel, regardless of the tracking policy. When the interaction ends,
+     * pending previews are cancelled and colorChanged is emitted as usual. The channel is not owned by the widget.
+     */
+    void setPreviewChannel(ColorPreviewChannel* channel);
+
+    /**
+     * @brief Get the asynchronous preview channel
+     * @return The preview channel, or nullptr if none is set
+     */
+    ColorPreviewChannel* previewChannel() const;
+
     /**
      * @brief Get the display status of the alpha channel
      * @return true if alpha channel is displayed in the widget
@@ -113,6 +194,76 @@ class ZTWIDGETS_EXPORT ColorPicker : public QWidget
      */
     void setEditType(EditType type);
 
+    /**
+     * @brief Set when colorChanging is emitted while the color is being changed
+     * @param policy The new tracking policy
+     *
+     * @note A bound model receives intermediate colors according to the same policy
+     */
+    void setTrackingPolicy(TrackingPolicy policy);
+
+    /**
+     * @brief Current tracking policy
+     * @return Current tracking policy
+     */
+    TrackingPolicy trackingPolicy() const;
+
+    /**
+     * @brief Set the interval used by TrackThrottled and TrackOnIdle
+     * @param msec Interval in milliseconds, e.g. 40 to emit at most 25 times per second
+     */
+    void setTrackingInterval(int msec);
+
+    /**
+     * @brief Current tracking interval
+     * @return Current tracking interval in milliseconds
+     */
+    int trackingInterval() const;
+
+    /**
+     * @brief Enable or disable lightweight mode
+     * @param lightweight true if the widget should draw and edit the color itself
+     *
+     * By default, the widget hosts a color display and a line edit widget. A lightweight widget paints the color swatch
+     * and the hex value itself, and edits the hex value inline. This is considerably cheaper when many widgets are used.
+     *
+     * Child widgets are created when the widget is first polished, so enabling this before the widget is shown means
+     * they are never created.
+     */
+    void setLightweight(bool lightweight);
+
+    /**
+     * @brief Get the lightweight status of the widget
+     * @return true if the widget is in lightweight mode
+     */
+    bool lightweight() const;
+
+    /**
+     * @brief Draw a color swatch and its hex value without a widget
+     * @param painter The painter to draw with
+     * @param option Describes the swatch to draw
+     *
+     * Draws the swatch exactly like a lightweight ColorPicker which is not being edited, for use by item delegates,
+     * graphics items, printing and other places where creating a widget per color is not an option. The painter state
+     * is left unchanged.
+     */
+    static void paintSwatch(QPainter* painter, const ColorSwatchStyleOption& option);
+
+    /**
+     * @brief Draw a hue and saturation wheel without a widget
+     * @param painter The painter to draw with
+     * @param option Describes the wheel to draw
+     *
+     * Draws the wheel shown by the color picker popup, fitted to the largest square within the bounds, along with the
+     * marker for the color. The painter state is left unchanged.
+     */
+    static void paintWheel(QPainter* painter, const ColorWheelStyleOption& option);
+
+    /**
+     * @brief Overridden from QWidget
+     */
+    QSize sizeHint() const override;
+
   Q_SIGNALS:
     /**
      * @param color The new color
@@ -128,8 +279,79 @@ class ZTWIDGETS_EXPORT ColorPicker : public QWidget
      */
     void colorChanging(const QColor& color);
 
+  protected:
+    /**
+     * @brief Overridden from QWidget
+     */
+    bool event(QEvent* event) override;
+
+    /**
+     * @brief Overridden from QWidget
+     */
+    void showEvent(QShowEvent* event) override;
+
+    /**
+     * @brief Overridden from QWidget
+     */
+    void paintEvent(QPaintEvent* event) override;
+
+    /**
+     * @brief Overridden from QWidget
+     */
+    void mouseReleaseEvent(QMouseEvent* event) override;
+
+    /**
+     * @brief Overridden from QWidget
+     */
+    void keyPressEvent(QKeyEvent* event) override;
+
+    /**
+     * @brief Overridden from QWidget
+     */
+    void focusOutEvent(QFocusEvent* event) override;
+
+    /**
+     * @brief Overridden from QWidget
+     *
+     * Accepts colors and text in any format supported by the picker.
+     */
+    void dragEnterEvent(QDragEnterEvent* event) override;
+
+    /**
+     * @brief Overridden from QWidget
+     */
+    void dropEvent(QDropEvent* event) override;
+
   private:
     ColorPickerPrivate* const m_Impl;
 };
 
+/**
+ * @brief Describes a color swatch drawn by ColorPicker::paintSwatch()
+ *
+ * The defaults match those of a new ColorPicker.
+ */
+struct ZTWIDGETS_EXPORT ColorSwatchStyleOption
+{
+    ColorSwatchStyleOption();
+
+    QRect rect;        ///< Bounds of the swatch and its hex value
+    QPalette palette;  ///< Colors of the text box
+    QFont font;        ///< Font of the hex value
+    QColor color;      ///< The color
+    bool displayAlpha; ///< Draw the alpha channel of the color, and include it in the hex value
+    bool displayText;  ///< Draw the hex value. If not set, the swatch fills the bounds.
+};
+
+/**
+ * @brief Describes a hue and saturation wheel drawn by ColorPicker::paintWheel()
+ */
+struct ZTWIDGETS_EXPORT ColorWheelStyleOption
+{
+    ColorWheelStyleOption();
+
+    QRect rect;   ///< Bounds of the wheel
+    QColor color; ///< The marked color. Its value decides the brightness of the wheel.
+};
+
 #endif // COLORPICKER_H
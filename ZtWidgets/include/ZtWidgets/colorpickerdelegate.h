@@ -0,0 +1,154 @@
+/*
+ * Copyright (c) 2021 Victor Wåhlström
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ * claim that you wrote the original software. If you use this software
+ * in a product, an acknowledgment in the product documentation would be
+ * appreciated but is not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source
+ */
+
+
+#ifndef COLORPICKERDELEGATE_H
+#define COLORPICKERDELEGATE_H
+
+#include "colorpicker.h"
+#include "ztwidgets_global.h"
+
+#include <QStyledItemDelegate>
+
+class ColorPickerDelegatePrivate;
+
+/**
+ * @brief An item delegate displaying and editing colors as a ColorPicker
+ *
+ * Items are painted as a color swatch and hex value with the same drawing code as a lightweight ColorPicker, straight
+ * from the model data, so no widget exists for an item until it is edited. The color is read from Qt::EditRole and
+ * written back to it. Items without a valid color are painted by QStyledItemDelegate.
+ */
+class ZTWIDGETS_EXPORT ColorPickerDelegate : public QStyledItemDelegate
+{
+    Q_OBJECT
+
+    Q_DISABLE_COPY(ColorPickerDelegate)
+
+    /**
+     * @brief Show or hide the alpha channel
+     */
+    Q_PROPERTY(bool displayAlpha READ displayAlpha WRITE setDisplayAlpha)
+
+    /**
+     * @brief Select the type used by the editor when directly editing values
+     */
+    Q_PROPERTY(ColorPicker::EditType editType READ editType WRITE setEditType)
+
+    /**
+     * @brief This property holds the number of idle editors kept for reuse
+     */
+    Q_PROPERTY(int editorPoolSize READ editorPoolSize WRITE setEditorPoolSize)
+
+  public:
+    /**
+     * @brief Construct an instance of ColorPickerDelegate
+     * @param parent Parent object
+     */
+    explicit ColorPickerDelegate(QObject* parent = nullptr);
+
+    virtual ~ColorPickerDelegate();
+
+    /**
+     * @brief Show or hide the alpha channel
+     * @param visible true if alpha channel should be visible
+     */
+    void setDisplayAlpha(bool visible);
+
+    /**
+     * @brief Get the display status of the alpha channel
+     * @return true if alpha channel is displayed
+     */
+    bool displayAlpha() const;
+
+    /**
+     * @brief Set the type used by the editor when directly editing values
+     */
+    void setEditType(ColorPicker::EditType type);
+
+    /**
+     * @brief Get the type used by the editor when directly editing values
+     */
+    ColorPicker::EditType editType() const;
+
+    /**
+     * @brief Set the number of idle editors kept for reuse
+     * @param size Number of editors, or 0 to create a new editor for every edited item
+     *
+     * Editors closed by a view are kept hidden and reused for the next edited item, so moving from one item to the
+     * next does not create and destroy a ColorPicker, nor its popup once it has been shown. Excess idle editors are
+     * deleted. The default is 2.
+     */
+    void setEditorPoolSize(int size);
+
+    /**
+     * @brief Number of idle editors kept for reuse
+     */
+    int editorPoolSize() const;
+
+    /**
+     * @brief Overridden from QStyledItemDelegate
+     */
+    void paint(QPainter* painter, const QStyleOptionViewItem& option, const QModelIndex& index) const override;
+
+    /**
+     * @brief Overridden from QStyledItemDelegate
+     */
+    QSize sizeHint(const QStyleOptionViewItem& option, const QModelIndex& index) const override;
+
+    /**
+     * @brief Overridden from QStyledItemDelegate
+     *
+     * Creates a lightweight ColorPicker configured like the delegate, or reuses an idle one. Changes made with it are
+     * committed to the model as soon as the color has changed.
+     */
+    QWidget* createEditor(QWidget* parent, const QStyleOptionViewItem& option, const QModelIndex& index) const override;
+
+    /**
+     * @brief Overridden from QStyledItemDelegate
+     *
+     * Keeps the editor for reuse unless the editor pool is full.
+     */
+    void destroyEditor(QWidget* editor, const QModelIndex& index) const override;
+
+    /**
+     * @brief Overridden from QStyledItemDelegate
+     */
+    void setEditorData(QWidget* editor, const QModelIndex& index) const override;
+
+    /**
+     * @brief Overridden from QStyledItemDelegate
+     */
+    void setModelData(QWidget* editor, QAbstractItemModel* model, const QModelIndex& index) const override;
+
+    /**
+     * @brief Overridden from QStyledItemDelegate
+     */
+    void updateEditorGeometry(QWidget* editor,
+                              const QStyleOptionViewItem& option,
+                              const QModelIndex& index) const override;
+
+  private:
+    ColorPickerDelegatePrivate* const m_Impl;
+};
+
+#endif // COLORPICKERDELEGATE_H
@@ -0,0 +1,119 @@
+/*
+ * Copyright (c) 2021 Victor Wåhlström
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ * claim that you wrote the original software. If you use this software
+ * in a product, an acknowledgment in the product documentation would be
+ * appreciated but is not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source
+ */
+
+
+#ifndef COLORPREVIEWCHANNEL_H
+#define COLORPREVIEWCHANNEL_H
+
+#include "ztwidgets_global.h"
+
+#include <QAtomicInt>
+#include <QColor>
+#include <QObject>
+#include <QSharedPointer>
+
+#include <functional>
+
+class ColorPreviewChannelPrivate;
+
+/**
+ * @brief Cancellation token passed along with each preview request
+ *
+ * A token is cancelled as soon as a newer request is posted, or the channel is cancelled. Long running handlers should
+ * check isCancelled() periodically and return early when it is set.
+ */
+class ZTWIDGETS_EXPORT ColorPreviewToken
+{
+  public:
+    /**
+     * @brief Construct a token which is never cancelled
+     */
+    ColorPreviewToken();
+
+    /**
+     * @brief Get the cancellation status of the request
+     * @return true if the request has been superseded or cancelled
+     */
+    bool isCancelled() const;
+
+  private:
+    friend class ColorPreviewChannelPrivate;
+
+    ColorPreviewToken(const QSharedPointer<QAtomicInt>& generation, int ticket);
+
+    QSharedPointer<QAtomicInt> m_Generation;
+    int m_Ticket;
+};
+
+/**
+ * @brief Delivers intermediate colors to an expensive consumer without blocking the GUI thread
+ *
+ * Colors posted to the channel are handed to the handler on a worker thread from the global QThreadPool. Only the
+ * most recently posted color is kept; requests posted while the handler is busy replace each other, and only the
+ * latest one is delivered once the handler returns. At most one handler invocation per channel is running at any time.
+ *
+ * The handler is called on a worker thread. Results that affect widgets must be passed back to the GUI thread, e.g.
+ * using QMetaObject::invokeMethod() with a queued connection.
+ *
+ * See ColorPicker::setPreviewChannel()
+ */
+class ZTWIDGETS_EXPORT ColorPreviewChannel : public QObject
+{
+    Q_OBJECT
+
+    Q_DISABLE_COPY(ColorPreviewChannel)
+
+  public:
+    /**
+     * @brief Handler invoked on a worker thread for each delivered request
+     */
+    typedef std::function<void(const QColor&, const ColorPreviewToken&)> Handler;
+
+    /**
+     * @brief Construct an instance of ColorPreviewChannel
+     * @param handler Handler invoked on a worker thread
+     * @param parent Parent object
+     */
+    explicit ColorPreviewChannel(Handler handler, QObject* parent = nullptr);
+
+    /**
+     * @brief Destructor. Cancels pending requests and waits for a running handler to return.
+     */
+    virtual ~ColorPreviewChannel();
+
+    /**
+     * @brief Post a color to the handler, superseding any request which has not yet been delivered
+     * @param color The color to preview
+     */
+    void post(const QColor& color);
+
+    /**
+     * @brief Drop any pending request and cancel the token of a running one
+     */
+    void cancel();
+
+  private:
+    // shared with the worker, which may still be releasing the mutex once the channel has seen it finish
+    const QSharedPointer<ColorPreviewChannelPrivate> m_Impl;
+};
+
+#endif // COLORPREVIEWCHANNEL_H
@@ -25,10 +25,22 @@
 
 #include "ztwidgets_global.h"
 
+#include <QFont>
+#include <QLocale>
+#include <QPalette>
+#include <QPointF>
+#include <QSharedPointer>
 #include <QString>
+#include <QVector>
 #include <QWidget>
 
+#include <functional>
+
+class QPainter;
 class SliderEditPrivate;
+class SliderHistogram;
+class SliderValueSource;
+struct SliderEditStyleOption;
 
 /**
  * @brief The SliderEdit class provides a horizontal slider with editing capabilities
@@ -90,6 +102,14 @@ class ZTWIDGETS_EXPORT SliderEdit : public QWidget
      */
     Q_PROPERTY(quint32 precision READ precision WRITE setPrecision)
 
+    /**
+     * @brief This property controls whether the value is displayed and parsed using the widget's locale
+     *
+     * When enabled the locale's decimal point, digit grouping and negative sign are used. Disabled by default, in
+     * which case values are always displayed on the form 1234.5.
+     */
+    Q_PROPERTY(bool localizedNumbers READ localizedNumbers WRITE setLocalizedNumbers)
+
     /**
      * @brief This property holds the alignment of any displayed text in the widget
      */
@@ -119,6 +139,21 @@ class ZTWIDGETS_EXPORT SliderEdit : public QWidget
      */
     Q_PROPERTY(ValueMapping valueMapping READ valueMapping WRITE setValueMapping)
 
+    /**
+     * @brief This property holds the exponent used by ValueMapping::PowerScale
+     */
+    Q_PROPERTY(qreal mappingExponent READ mappingExponent WRITE setMappingExponent)
+
+    /**
+     * @brief This property controls how often valueChanging is emitted during an interaction
+     */
+    Q_PROPERTY(TrackingPolicy trackingPolicy READ trackingPolicy WRITE setTrackingPolicy)
+
+    /**
+     * @brief This property holds the interval, in milliseconds, used by time based tracking policies
+     */
+    Q_PROPERTY(int trackingInterval READ trackingInterval WRITE setTrackingInterval)
+
   public:
     /**
      * @brief Supported components
@@ -151,12 +186,44 @@ class ZTWIDGETS_EXPORT SliderEdit : public QWidget
      */
     enum ValueMapping
     {
-        LinearScale      = 0, ///< Linear scaling. One-to-one correlation between values and position on the slider
-        LogarithmicScale = 1, ///< Logarithmic scaling. The value increases exponentially along the slider
+        LinearScale       = 0, ///< Linear scaling. One-to-one correlation between values and position on the slider
+        LogarithmicScale  = 1, ///< Logarithmic scaling. The value increases exponentially along the slider
+        PowerScale        = 2, ///< Power scaling. The value increases by the power of mappingExponent along the slider
+        SquareRootScale   = 3, ///< Square root scaling. The position is proportional to the square root of the value
+        SymmetricLogScale = 4, ///< Symmetric logarithmic scaling, for ranges crossing zero. Linear close to zero
+        DecibelScale      = 5, ///< Decibel scaling of linear amplitudes. Position is proportional to the level in dB
+        CustomScale       = 6, ///< Custom scaling using the curve set by setValueCurve()
     };
 
     Q_ENUM(ValueMapping)
 
+    /**
+     * @brief Determines when valueChanging is emitted while the value is being changed
+     *
+     * valueChanged is always emitted once the interaction ends, regardless of the policy.
+     */
+    enum TrackingPolicy
+    {
+        TrackAlways    = 0, ///< Emit valueChanging for every change
+        TrackThrottled = 1, ///< Emit valueChanging at most once per trackingInterval()
+        TrackOnIdle    = 2, ///< Emit valueChanging once the value has not changed for trackingInterval()
+        TrackOnRelease = 3, ///< Never emit valueChanging
+    };
+
+    Q_ENUM(TrackingPolicy)
+
+    /**
+     * @brief Options for bindProperty()
+     */
+    enum PropertyBindingFlag
+    {
+        ReadOnlyBinding = 1 << 0, ///< Only follow the property, never write to it
+        CoalesceChanges = 1 << 1, ///< Apply changes at most once per frame, in both directions
+    };
+
+    Q_DECLARE_FLAGS(PropertyBinding, PropertyBindingFlag)
+    Q_FLAG(PropertyBinding)
+
     /**
      * @brief Construct an instance of SliderEdit
      * @param parent Parent widget
@@ -203,10 +270,32 @@ class ZTWIDGETS_EXPORT SliderEdit : public QWidget
      * @param minimum The new minimum
      * @param maximum The new maximum
      *
-     * @note Calling this is equivalent to setMinimum(minimum); setMaximum(maximum);
+     * @note Calling this is equivalent to setMinimum(minimum); setMaximum(maximum); within a batch, so valueChanged is
+     * emitted at most once
      */
     void setRange(qreal minimum, qreal maximum);
 
+    /**
+     * @brief Start a batch of configuration changes
+     *
+     * Until the matching endBatch(), valueChanged is not emitted and the widget is not repainted. This makes it cheap
+     * to reconfigure the range, precision, behavior and value of many sliders at once. Batches can be nested.
+     *
+     * @sa endBatch()
+     */
+    void beginBatch();
+
+    /**
+     * @brief End a batch of configuration changes
+     *
+     * When the outermost batch ends, the widget is repainted once if anything affecting its appearance changed.
+     * valueChanged is emitted once if setValue() was called during the batch and the value differs from the value
+     * when the batch started. setValue() may also be called implicitly, e.g. by setMinimum() and setMaximum().
+     *
+     * @sa beginBatch()
+     */
+    void endBatch();
+
     /**
      * @brief Get the edit status of the widget
      * @return true if the slider widget can be edited with a keyboard, false otherwise
@@ -294,6 +383,18 @@ class ZTWIDGETS_EXPORT SliderEdit : public QWidget
      */
     quint32 precision() const;
 
+    /**
+     * @brief Display and parse the value using the widget's locale
+     * @param localized true if the locale should be used
+     */
+    void setLocalizedNumbers(bool localized);
+
+    /**
+     * @brief Get whether the value is displayed and parsed using the widget's locale
+     * @return true if the locale is used
+     */
+    bool localizedNumbers() const;
+
     /**
      * @brief This property holds the active slider components used by the widget
      * @param components components this slider widget should use
@@ -330,6 +431,39 @@ class ZTWIDGETS_EXPORT SliderEdit : public QWidget
      */
     ValueMapping valueMapping() const;
 
+    /**
+     * @brief Set the exponent used by ValueMapping::PowerScale
+     * @param exponent A positive exponent. Values above 1 give finer control at the low end of the range.
+     */
+    void setMappingExponent(qreal exponent);
+
+    /**
+     * @brief Exponent used by ValueMapping::PowerScale
+     * @return Current exponent
+     */
+    qreal mappingExponent() const;
+
+    /**
+     * @brief Map values using a curve through a set of control points
+     * @param points Control points on the form (position, value), where both are in the range [0, 1]. The position is
+     * relative to the slider and the value relative to the range. Values must not decrease with the position.
+     *
+     * The points are interpolated using a monotone cubic spline, sampled into a table. Sets the value mapping to
+     * ValueMapping::CustomScale.
+     */
+    void setValueCurve(const QVector<QPointF>& points);
+
+    /**
+     * @brief Map values using a function
+     * @param curve Function mapping a position in [0, 1] to a value in [0, 1], relative to the range. Must not
+     * decrease with the position.
+     * @param samples Number of times the function is sampled
+     *
+     * The function is only called by this function, so it may be arbitrarily expensive. Sets the value mapping to
+     * ValueMapping::CustomScale.
+     */
+    void setValueCurve(const std::function<qreal(qreal)>& curve, int samples = 256);
+
     /**
      * @brief Set the alignment of any text displayed in the widget
      * @param alignment Alignment of the text. This includes the label, value, and unit.
@@ -354,6 +488,105 @@ class ZTWIDGETS_EXPORT SliderEdit : public QWidget
      */
     Qt::Orientation orientation() const;
 
+    /**
+     * @brief Set when valueChanging is emitted while the value is being changed
+     * @param policy The new tracking policy
+     */
+    void setTrackingPolicy(TrackingPolicy policy);
+
+    /**
+     * @brief Current tracking policy
+     * @return Current tracking policy
+     */
+    TrackingPolicy trackingPolicy() const;
+
+    /**
+     * @brief Set the interval used by TrackThrottled and TrackOnIdle
+     * @param msec Interval in milliseconds, e.g. 40 to emit at most 25 times per second
+     */
+    void setTrackingInterval(int msec);
+
+    /**
+     * @brief Current tracking interval
+     * @return Current tracking interval in milliseconds
+     */
+    int trackingInterval() const;
+
+    /**
+     * @brief Display a value written by another thread
+     * @param source The source to display, or nullptr to return to normal operation
+     *
+     * While a source is set, the widget is a read-only meter. It ignores mouse and keyboard input and shows the value
+     * of the source, which is read once per frame. The widget is only repainted when it is visible and the value has
+     * changed. valueChanged and valueChanging are not emitted for values read from the source.
+     *
+     * Any number of widgets can display the same source.
+     */
+    void setValueSource(const QSharedPointer<SliderValueSource>& source);
+
+    /**
+     * @brief Get the source displayed by the widget
+     * @return The source, or nullptr if the widget is not a meter
+     */
+    QSharedPointer<SliderValueSource> valueSource() const;
+
+    /**
+     * @brief Draw the distribution of a stream of samples on the track
+     * @param histogram The histogram to draw, or nullptr to remove it
+     *
+     * Pending samples are binned once per frame, and the widget is repainted when the histogram has changed. The
+     * histogram is drawn underneath the gauge. It is cleared whenever the range or value mapping of the widget
+     * changes.
+     */
+    void setHistogram(const QSharedPointer<SliderHistogram>& histogram);
+
+    /**
+     * @brief Get the histogram drawn on the track
+     * @return The histogram, or nullptr if none is set
+     */
+    QSharedPointer<SliderHistogram> histogram() const;
+
+    /**
+     * @brief Keep the value in sync with a numeric property of another object
+     * @param object The object to bind to
+     * @param name Name of the property
+     * @param options Binding options
+     * @return false if the property does not exist, is not numeric, or is read-only and ReadOnlyBinding is not set
+     *
+     * The property and its notify signal are resolved once, so that every change is a single read or write of the
+     * property. Values set through the widget are written to the property, and changes announced by its notify
+     * signal are shown by the widget without emitting valueChanged or valueChanging. Changes which originate from
+     * the binding itself are not passed back, so the two never feed each other.
+     *
+     * With CoalesceChanges, only the latest value of each frame is read or written. The value at the end of an
+     * interaction is always written immediately.
+     *
+     * Replaces any existing binding. The binding ends when the object is destroyed.
+     */
+    bool bindProperty(QObject* object, const char* name, PropertyBinding options = PropertyBinding());
+
+    /**
+     * @brief Remove the binding set by bindProperty()
+     */
+    void unbindProperty();
+
+    /**
+     * @brief Get the object the value is bound to
+     * @return The bound object, or nullptr if the value is not bound
+     */
+    QObject* boundObject() const;
+
+    /**
+     * @brief Draw a slider without a widget
+     * @param painter The painter to draw with
+     * @param option Describes the slider to draw
+     *
+     * Draws the slider exactly like a SliderEdit which is not being edited and does not have focus, for use by item
+     * delegates, graphics items, printing and other places where creating a widget per slider is not an option. The
+     * painter state is left unchanged.
+     */
+    static void paint(QPainter* painter, const SliderEditStyleOption& option);
+
   Q_SIGNALS:
     /**
      * @param value The new value
@@ -380,6 +613,11 @@ class ZTWIDGETS_EXPORT SliderEdit : public QWidget
      */
     void keyPressEvent(QKeyEvent*) override;
 
+    /**
+     * @brief Overridden from QWidget
+     */
+    void keyReleaseEvent(QKeyEvent*) override;
+
     /**
      * @brief Overridden from QWidget
      */
@@ -410,11 +648,75 @@ class ZTWIDGETS_EXPORT SliderEdit : public QWidget
      */
     void focusOutEvent(QFocusEvent*) override;
 
+    /**
+     * @brief Overridden from QWidget
+     */
+    void changeEvent(QEvent*) override;
+
+    /**
+     * @brief Normalize a value before it is stored
+     * @param value A value set programmatically, typed by the user, or picked with the mouse or keyboard
+     * @return The value to store, before it is clamped to the range
+     *
+     * The default implementation rounds the value to precision() if SliderBehaviorFlag::SnapToPrecision is set.
+     * Override this to restrict the values the slider can hold, e.g. to integers. Values set programmatically are
+     * clamped to the range before they are passed in, so an override which keeps values inside the range inside it
+     * never has its result clamped to a bound it can not represent.
+     */
+    virtual qreal normalizeValue(qreal value) const;
+
+    /**
+     * @brief Number of decimals used when displaying and editing a value
+     * @return The number of decimals. The default implementation returns precision().
+     */
+    virtual quint32 valueDecimals() const;
+
+    /**
+     * @brief Parse text typed by the user
+     * @param text The text to parse
+     * @param value Receives the parsed value
+     * @return true if the text could be parsed
+     *
+     * The default implementation parses a floating point number, using the widget's locale if localizedNumbers is
+     * set. The parsed value is passed through normalizeValue() before it is stored.
+     */
+    virtual bool parseValue(const QString& text, qreal* value) const;
+
   private:
+    friend class SliderEditPrivate;
+
     SliderEditPrivate* const m_Impl;
 };
 
 Q_DECLARE_OPERATORS_FOR_FLAGS(SliderEdit::SliderComponents)
 Q_DECLARE_OPERATORS_FOR_FLAGS(SliderEdit::SliderBehavior)
+Q_DECLARE_OPERATORS_FOR_FLAGS(SliderEdit::PropertyBinding)
+
+/**
+ * @brief Describes a slider drawn by SliderEdit::paint()
+ *
+ * The defaults match those of a new SliderEdit.
+ */
+struct ZTWIDGETS_EXPORT SliderEditStyleOption
+{
+    SliderEditStyleOption();
+
+    QRect rect;                                    ///< Bounds of the slider
+    QPalette palette;                              ///< Colors of the slider
+    QFont font;                                    ///< Font of the displayed text
+    QLocale locale;                                ///< Locale used if localizedNumbers is set
+    QString label;                                 ///< Displayed label
+    QString unit;                                  ///< Unit displayed after the value
+    qreal value;                                   ///< The value. The gauge is clamped to the range.
+    qreal minimum;                                 ///< Minimum value
+    qreal maximum;                                 ///< Maximum value
+    qreal mappingExponent;                         ///< Exponent used by SliderEdit::PowerScale
+    quint32 precision;                             ///< Number of displayed decimals
+    Qt::Alignment alignment;                       ///< Alignment of the displayed text
+    Qt::Orientation orientation;                   ///< Orientation. Text is only drawn on horizontal sliders.
+    SliderEdit::SliderComponents sliderComponents; ///< Components to draw
+    SliderEdit::ValueMapping valueMapping;         ///< Mapping. SliderEdit::CustomScale is drawn as linear.
+    bool localizedNumbers;                         ///< Format the value with the separators of locale
+};
 
 #endif // SLIDEREDIT_H
@@ -0,0 +1,313 @@
+/*
+ * Copyright (c) 2021 Victor Wåhlström
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ * claim that you wrote the original software. If you use this software
+ * in a product, an acknowledgment in the product documentation would be
+ * appreciated but is not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source
+ */
+
+
+#ifndef SLIDEREDITDELEGATE_H
+#define SLIDEREDITDELEGATE_H
+
+#include "slideredit.h"
+#include "ztwidgets_global.h"
+
+#include <QStyledItemDelegate>
+
+class SliderEditDelegatePrivate;
+
+/**
+ * @brief An item delegate displaying and editing numeric model data as a SliderEdit
+ *
+ * Items are painted with the same drawing code as SliderEdit, straight from the model data, so no widget exists for
+ * an item until it is edited. The value is read from Qt::EditRole and written back to it.
+ *
+ * Range, precision and the other settings apply to every item. The range can be overridden per item by setting
+ * roles from which the minimum and maximum are read.
+ */
+class ZTWIDGETS_EXPORT SliderEditDelegate : public QStyledItemDelegate
+{
+    Q_OBJECT
+
+    Q_DISABLE_COPY(SliderEditDelegate)
+
+    /**
+     * @brief This property holds the minimum value of items without a minimum of their own
+     */
+    Q_PROPERTY(qreal minimum READ minimum WRITE setMinimum)
+
+    /**
+     * @brief This property holds the maximum value of items without a maximum of their own
+     */
+    Q_PROPERTY(qreal maximum READ maximum WRITE setMaximum)
+
+    /**
+     * @brief This property holds the step used by the arrow keys while editing
+     */
+    Q_PROPERTY(qreal singleStep READ singleStep WRITE setSingleStep)
+
+    /**
+     * @brief This property holds the step used by the Page Up and Page Down keys while editing
+     */
+    Q_PROPERTY(qreal pageStep READ pageStep WRITE setPageStep)
+
+    /**
+     * @brief This property holds the unit displayed after the value
+     */
+    Q_PROPERTY(QString unit READ unit WRITE setUnit)
+
+    /**
+     * @brief This property holds the number of displayed decimals
+     */
+    Q_PROPERTY(quint32 precision READ precision WRITE setPrecision)
+
+    /**
+     * @brief This property controls whether values are formatted with the separators of the locale
+     */
+    Q_PROPERTY(bool localizedNumbers READ localizedNumbers WRITE setLocalizedNumbers)
+
+    /**
+     * @brief This property holds the alignment of the displayed text
+     */
+    Q_PROPERTY(Qt::Alignment alignment READ alignment WRITE setAlignment)
+
+    /**
+     * @brief This property holds the slider components drawn for every item
+     */
+    Q_PROPERTY(SliderEdit::SliderComponents sliderComponents READ sliderComponents WRITE setSliderComponents)
+
+    /**
+     * @brief This property holds how values are mapped on the sliders
+     */
+    Q_PROPERTY(SliderEdit::ValueMapping valueMapping READ valueMapping WRITE setValueMapping)
+
+    /**
+     * @brief This property holds the exponent used by SliderEdit::PowerScale
+     */
+    Q_PROPERTY(qreal mappingExponent READ mappingExponent WRITE setMappingExponent)
+
+    /**
+     * @brief This property holds the number of idle editors kept for reuse
+     */
+    Q_PROPERTY(int editorPoolSize READ editorPoolSize WRITE setEditorPoolSize)
+
+  public:
+    /**
+     * @brief Construct an instance of SliderEditDelegate
+     * @param parent Parent object
+     */
+    explicit SliderEditDelegate(QObject* parent = nullptr);
+
+    virtual ~SliderEditDelegate();
+
+    /**
+     * @brief Set the minimum value of items without a minimum of their own
+     */
+    void setMinimum(qreal minimum);
+
+    /**
+     * @brief Minimum value of items without a minimum of their own
+     */
+    qreal minimum() const;
+
+    /**
+     * @brief Set the maximum value of items without a maximum of their own
+     */
+    void setMaximum(qreal maximum);
+
+    /**
+     * @brief Maximum value of items without a maximum of their own
+     */
+    qreal maximum() const;
+
+    /**
+     * @brief Set the range of items without a range of their own
+     */
+    void setRange(qreal minimum, qreal maximum);
+
+    /**
+     * @brief Read the range of each item from the model
+     * @param minimum_role Role holding the minimum value of an item, or -1 to use minimum()
+     * @param maximum_role Role holding the maximum value of an item, or -1 to use maximum()
+     *
+     * Items without valid data for a role use the range of the delegate.
+     */
+    void setRangeRoles(int minimum_role, int maximum_role);
+
+    /**
+     * @brief Role holding the minimum value of an item, or -1 if not set
+     */
+    int minimumRole() const;
+
+    /**
+     * @brief Role holding the maximum value of an item, or -1 if not set
+     */
+    int maximumRole() const;
+
+    /**
+     * @brief Set the step used by the arrow keys while editing
+     */
+    void setSingleStep(qreal step);
+
+    /**
+     * @brief Step used by the arrow keys while editing
+     */
+    qreal singleStep() const;
+
+    /**
+     * @brief Set the step used by the Page Up and Page Down keys while editing
+     */
+    void setPageStep(qreal step);
+
+    /**
+     * @brief Step used by the Page Up and Page Down keys while editing
+     */
+    qreal pageStep() const;
+
+    /**
+     * @brief Set the unit displayed after the value
+     */
+    void setUnit(const QString& unit);
+
+    /**
+     * @brief Unit displayed after the value
+     */
+    QString unit() const;
+
+    /**
+     * @brief Set the number of displayed decimals
+     */
+    void setPrecision(quint32 precision);
+
+    /**
+     * @brief Number of displayed decimals
+     */
+    quint32 precision() const;
+
+    /**
+     * @brief Format values with the decimal and group separators of the locale of the view
+     */
+    void setLocalizedNumbers(bool localized);
+
+    /**
+     * @brief true if values are formatted with the separators of the locale
+     */
+    bool localizedNumbers() const;
+
+    /**
+     * @brief Set the alignment of the displayed text
+     */
+    void setAlignment(Qt::Alignment alignment);
+
+    /**
+     * @brief Alignment of the displayed text
+     */
+    Qt::Alignment alignment() const;
+
+    /**
+     * @brief Set the slider components drawn for every item
+     */
+    void setSliderComponents(SliderEdit::SliderComponents components);
+
+    /**
+     * @brief Slider components drawn for every item
+     */
+    SliderEdit::SliderComponents sliderComponents() const;
+
+    /**
+     * @brief Set how values are mapped on the sliders
+     * @note SliderEdit::CustomScale is not supported and behaves like SliderEdit::LinearScale
+     */
+    void setValueMapping(SliderEdit::ValueMapping mapping);
+
+    /**
+     * @brief How values are mapped on the sliders
+     */
+    SliderEdit::ValueMapping valueMapping() const;
+
+    /**
+     * @brief Set the exponent used by SliderEdit::PowerScale
+     */
+    void setMappingExponent(qreal exponent);
+
+    /**
+     * @brief Exponent used by SliderEdit::PowerScale
+     */
+    qreal mappingExponent() const;
+
+    /**
+     * @brief Set the number of idle editors kept for reuse
+     * @param size Number of editors, or 0 to create a new editor for every edited item
+     *
+     * Editors closed by a view are kept hidden and reused for the next edited item, so moving from one item to the
+     * next does not create and destroy a SliderEdit. Excess idle editors are deleted. The default is 2.
+     */
+    void setEditorPoolSize(int size);
+
+    /**
+     * @brief Number of idle editors kept for reuse
+     */
+    int editorPoolSize() const;
+
+    /**
+     * @brief Overridden from QStyledItemDelegate
+     */
+    void paint(QPainter* painter, const QStyleOptionViewItem& option, const QModelIndex& index) const override;
+
+    /**
+     * @brief Overridden from QStyledItemDelegate
+     */
+    QSize sizeHint(const QStyleOptionViewItem& option, const QModelIndex& index) const override;
+
+    /**
+     * @brief Overridden from QStyledItemDelegate
+     *
+     * Creates a SliderEdit configured like the delegate, or reuses an idle one. Changes made with it are committed to
+     * the model as soon as the value has changed.
+     */
+    QWidget* createEditor(QWidget* parent, const QStyleOptionViewItem& option, const QModelIndex& index) const override;
+
+    /**
+     * @brief Overridden from QStyledItemDelegate
+     *
+     * Keeps the editor for reuse unless the editor pool is full.
+     */
+    void destroyEditor(QWidget* editor, const QModelIndex& index) const override;
+
+    /**
+     * @brief Overridden from QStyledItemDelegate
+     */
+    void setEditorData(QWidget* editor, const QModelIndex& index) const override;
+
+    /**
+     * @brief Overridden from QStyledItemDelegate
+     */
+    void setModelData(QWidget* editor, QAbstractItemModel* model, const QModelIndex& index) const override;
+
+    /**
+     * @brief Overridden from QStyledItemDelegate
+     */
+    void updateEditorGeometry(QWidget* editor,
+                              const QStyleOptionViewItem& option,
+                              const QModelIndex& index) const override;
+
+  private:
+    SliderEditDelegatePrivate* const m_Impl;
+};
+
+#endif // SLIDEREDITDELEGATE_H
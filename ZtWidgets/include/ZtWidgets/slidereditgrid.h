@@ -0,0 +1,282 @@
+/*
+ * Copyright (c) 2021 Victor Wåhlström
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ * claim that you wrote the original software. If you use this software
+ * in a product, an acknowledgment in the product documentation would be
+ * appreciated but is not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source
+ */
+
+
+#ifndef SLIDEREDITGRID_H
+#define SLIDEREDITGRID_H
+
+#include "slideredit.h"
+#include "ztwidgets_global.h"
+
+#include <QAbstractScrollArea>
+
+class SliderEditGridPrivate;
+class SliderValueStore;
+
+/**
+ * @brief A scrollable column of sliders for very large numbers of values
+ *
+ * Displays and edits the rows of a SliderValueStore. Each row looks and behaves like a horizontal SliderEdit, as in
+ * SliderEditGroup, but only the rows which are visible are ever painted or hit-tested, so the cost of the widget does
+ * not depend on the number of rows. The store is not owned by the grid, and changes made to it are reflected by the
+ * grid.
+ *
+ * Steps, alignment, components and tracking apply to every row.
+ */
+class ZTWIDGETS_EXPORT SliderEditGrid : public QAbstractScrollArea
+{
+    Q_OBJECT
+
+    Q_DISABLE_COPY(SliderEditGrid)
+
+    /**
+     * @brief This property holds the row which receives keyboard input
+     */
+    Q_PROPERTY(int currentIndex READ currentIndex WRITE setCurrentIndex)
+
+    /**
+     * @brief This property holds the step used by the arrow keys
+     */
+    Q_PROPERTY(qreal singleStep READ singleStep WRITE setSingleStep)
+
+    /**
+     * @brief This property holds the step used by the Page Up and Page Down keys
+     */
+    Q_PROPERTY(qreal pageStep READ pageStep WRITE setPageStep)
+
+    /**
+     * @brief This property holds the alignment of any displayed text
+     */
+    Q_PROPERTY(Qt::Alignment alignment READ alignment WRITE setAlignment)
+
+    /**
+     * @brief This property holds the slider components drawn for every row
+     */
+    Q_PROPERTY(SliderEdit::SliderComponents sliderComponents READ sliderComponents WRITE setSliderComponents)
+
+    /**
+     * @brief This property controls how often valueChanging is emitted during an interaction
+     */
+    Q_PROPERTY(SliderEdit::TrackingPolicy trackingPolicy READ trackingPolicy WRITE setTrackingPolicy)
+
+    /**
+     * @brief This property holds the interval, in milliseconds, used by time based tracking policies
+     */
+    Q_PROPERTY(int trackingInterval READ trackingInterval WRITE setTrackingInterval)
+
+  public:
+    /**
+     * @brief Construct an instance of SliderEditGrid
+     * @param parent Parent widget
+     */
+    explicit SliderEditGrid(QWidget* parent = nullptr);
+
+    virtual ~SliderEditGrid();
+
+    /**
+     * @brief Set the store holding the rows
+     * @param store The store to display, or nullptr to display nothing
+     */
+    void setStore(SliderValueStore* store);
+
+    /**
+     * @brief The store holding the rows, or nullptr if none is set
+     */
+    SliderValueStore* store() const;
+
+    /**
+     * @brief Set the row which receives keyboard input, scrolling it into view
+     */
+    void setCurrentIndex(int index);
+
+    /**
+     * @brief The row which receives keyboard input, or -1 if there are no rows
+     */
+    int currentIndex() const;
+
+    /**
+     * @brief Row at a position
+     * @param pos Position within the viewport
+     * @return The index of the row, or -1 if there is no row at pos
+     */
+    int indexAt(const QPoint& pos) const;
+
+    /**
+     * @brief Bounds of a row within the viewport
+     */
+    QRect rowRect(int index) const;
+
+    /**
+     * @brief Scroll the grid so that a row is visible
+     */
+    void scrollTo(int index);
+
+    /**
+     * @brief Set the step used by the arrow keys
+     */
+    void setSingleStep(qreal step);
+
+    /**
+     * @brief Step used by the arrow keys
+     */
+    qreal singleStep() const;
+
+    /**
+     * @brief Set the step used by the Page Up and Page Down keys
+     */
+    void setPageStep(qreal step);
+
+    /**
+     * @brief Step used by the Page Up and Page Down keys
+     */
+    qreal pageStep() const;
+
+    /**
+     * @brief Set the alignment of any displayed text
+     */
+    void setAlignment(Qt::Alignment alignment);
+
+    /**
+     * @brief Alignment of any displayed text
+     */
+    Qt::Alignment alignment() const;
+
+    /**
+     * @brief Set the slider components drawn for every row
+     */
+    void setSliderComponents(SliderEdit::SliderComponents components);
+
+    /**
+     * @brief Slider components drawn for every row
+     */
+    SliderEdit::SliderComponents sliderComponents() const;
+
+    /**
+     * @brief Set when valueChanging is emitted while a value is being changed
+     */
+    void setTrackingPolicy(SliderEdit::TrackingPolicy policy);
+
+    /**
+     * @brief Current tracking policy
+     */
+    SliderEdit::TrackingPolicy trackingPolicy() const;
+
+    /**
+     * @brief Set the interval used by SliderEdit::TrackThrottled and SliderEdit::TrackOnIdle
+     */
+    void setTrackingInterval(int msec);
+
+    /**
+     * @brief Current tracking interval
+     */
+    int trackingInterval() const;
+
+  Q_SIGNALS:
+    /**
+     * @param index The row which changed
+     * @param value The new value
+     *
+     * Emitted when the value of a row has been changed through the grid
+     */
+    void valueChanged(int index, qreal value);
+
+    /**
+     * @param index The row which is changing
+     * @param value The new value
+     *
+     * Emitted while the value of a row is being changed through the grid
+     */
+    void valueChanging(int index, qreal value);
+
+  protected:
+    /**
+     * @brief Overridden from QAbstractScrollArea
+     */
+    void paintEvent(QPaintEvent*) override;
+
+    /**
+     * @brief Overridden from QAbstractScrollArea
+     */
+    void resizeEvent(QResizeEvent*) override;
+
+    /**
+     * @brief Overridden from QAbstractScrollArea
+     */
+    void scrollContentsBy(int dx, int dy) override;
+
+    /**
+     * @brief Overridden from QAbstractScrollArea
+     */
+    void keyPressEvent(QKeyEvent*) override;
+
+    /**
+     * @brief Overridden from QWidget
+     */
+    void keyReleaseEvent(QKeyEvent*) override;
+
+    /**
+     * @brief Overridden from QAbstractScrollArea
+     */
+    void mousePressEvent(QMouseEvent*) override;
+
+    /**
+     * @brief Overridden from QAbstractScrollArea
+     */
+    void mouseMoveEvent(QMouseEvent*) override;
+
+    /**
+     * @brief Overridden from QAbstractScrollArea
+     */
+    void mouseReleaseEvent(QMouseEvent*) override;
+
+    /**
+     * @brief Overridden from QAbstractScrollArea
+     */
+    void mouseDoubleClickEvent(QMouseEvent*) override;
+
+    /**
+     * @brief Overridden from QWidget
+     */
+    void focusInEvent(QFocusEvent*) override;
+
+    /**
+     * @brief Overridden from QWidget
+     */
+    void focusOutEvent(QFocusEvent*) override;
+
+    /**
+     * @brief Overridden from QWidget
+     *
+     * Moves between rows while a value is edited as text.
+     */
+    bool focusNextPrevChild(bool next) override;
+
+    /**
+     * @brief Overridden from QWidget
+     */
+    void changeEvent(QEvent*) override;
+
+  private:
+    SliderEditGridPrivate* const m_Impl;
+};
+
+#endif // SLIDEREDITGRID_H
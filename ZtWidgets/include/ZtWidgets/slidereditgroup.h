@@ -0,0 +1,351 @@
+/*
+ * Copyright (c) 2021 Victor Wåhlström
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ * claim that you wrote the original software. If you use this software
+ * in a product, an acknowledgment in the product documentation would be
+ * appreciated but is not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source
+ */
+
+
+#ifndef SLIDEREDITGROUP_H
+#define SLIDEREDITGROUP_H
+
+#include "slideredit.h"
+#include "ztwidgets_global.h"
+
+#include <QWidget>
+
+class SliderEditGroupPrivate;
+
+/**
+ * @brief A column of sliders drawn and edited by a single widget
+ *
+ * Each row looks and behaves like a horizontal SliderEdit, but is stored as plain data rather than as a widget of
+ * its own. This makes panels with hundreds of values considerably cheaper to create, lay out and paint.
+ *
+ * Rows are addressed by index. Dragging, stepping with the keyboard and editing the value as text work like they do
+ * in SliderEdit, and apply to the row under the mouse or to the current row. Up and Down move between rows, and Tab
+ * moves from one edited row to the next.
+ */
+class ZTWIDGETS_EXPORT SliderEditGroup : public QWidget
+{
+    Q_OBJECT
+
+    Q_DISABLE_COPY(SliderEditGroup)
+
+    /**
+     * @brief This property holds the number of rows
+     */
+    Q_PROPERTY(int count READ count)
+
+    /**
+     * @brief This property holds the row which receives keyboard input
+     */
+    Q_PROPERTY(int currentIndex READ currentIndex WRITE setCurrentIndex)
+
+    /**
+     * @brief This property holds the alignment of any displayed text
+     */
+    Q_PROPERTY(Qt::Alignment alignment READ alignment WRITE setAlignment)
+
+    /**
+     * @brief This property holds the slider components drawn for every row
+     */
+    Q_PROPERTY(SliderEdit::SliderComponents sliderComponents READ sliderComponents WRITE setSliderComponents)
+
+    /**
+     * @brief This property controls how often valueChanging is emitted during an interaction
+     */
+    Q_PROPERTY(SliderEdit::TrackingPolicy trackingPolicy READ trackingPolicy WRITE setTrackingPolicy)
+
+    /**
+     * @brief This property holds the interval, in milliseconds, used by time based tracking policies
+     */
+    Q_PROPERTY(int trackingInterval READ trackingInterval WRITE setTrackingInterval)
+
+  public:
+    /**
+     * @brief Construct an instance of SliderEditGroup
+     * @param parent Parent widget
+     */
+    explicit SliderEditGroup(QWidget* parent = nullptr);
+
+    virtual ~SliderEditGroup();
+
+    /**
+     * @brief Append a row
+     * @param label The displayed label
+     * @param minimum Minimum value
+     * @param maximum Maximum value
+     * @return Index of the new row
+     */
+    int addRow(const QString& label, qreal minimum = 0.0, qreal maximum = 1.0);
+
+    /**
+     * @brief Remove a row. The rows after it move up by one index.
+     */
+    void removeRow(int index);
+
+    /**
+     * @brief Remove all rows
+     */
+    void clear();
+
+    /**
+     * @brief Number of rows
+     */
+    int count() const;
+
+    /**
+     * @brief Update the value of a row
+     * @note Does not emit a signal
+     */
+    void updateValue(int index, qreal value);
+
+    /**
+     * @brief Set the value of a row. Emits valueChanged if the value changes.
+     */
+    void setValue(int index, qreal value);
+
+    /**
+     * @brief Value of a row
+     */
+    qreal value(int index) const;
+
+    /**
+     * @brief Set the range of a row. The value is clamped to the new range.
+     */
+    void setRange(int index, qreal minimum, qreal maximum);
+
+    /**
+     * @brief Minimum value of a row
+     */
+    qreal minimum(int index) const;
+
+    /**
+     * @brief Maximum value of a row
+     */
+    qreal maximum(int index) const;
+
+    /**
+     * @brief Set the label of a row
+     */
+    void setLabel(int index, const QString& label);
+
+    /**
+     * @brief Label of a row
+     */
+    QString label(int index) const;
+
+    /**
+     * @brief Set the unit of a row
+     */
+    void setUnit(int index, const QString& unit);
+
+    /**
+     * @brief Unit of a row
+     */
+    QString unit(int index) const;
+
+    /**
+     * @brief Set the number of displayed decimals of a row
+     */
+    void setPrecision(int index, quint32 precision);
+
+    /**
+     * @brief Number of displayed decimals of a row
+     */
+    quint32 precision(int index) const;
+
+    /**
+     * @brief Set the small and big steps used when stepping the value of a row with the keyboard
+     */
+    void setSteps(int index, qreal single_step, qreal page_step);
+
+    /**
+     * @brief Small step of a row
+     */
+    qreal singleStep(int index) const;
+
+    /**
+     * @brief Big step of a row
+     */
+    qreal pageStep(int index) const;
+
+    /**
+     * @brief Set how values are mapped on the slider of a row
+     * @param mapping The mapping. SliderEdit::CustomScale is not supported and behaves like SliderEdit::LinearScale.
+     * @param exponent Exponent used by SliderEdit::PowerScale
+     */
+    void setValueMapping(int index, SliderEdit::ValueMapping mapping, qreal exponent = 2.0);
+
+    /**
+     * @brief Value mapping of a row
+     */
+    SliderEdit::ValueMapping valueMapping(int index) const;
+
+    /**
+     * @brief Exponent used by SliderEdit::PowerScale for a row
+     */
+    qreal mappingExponent(int index) const;
+
+    /**
+     * @brief Set the row which receives keyboard input
+     */
+    void setCurrentIndex(int index);
+
+    /**
+     * @brief The row which receives keyboard input, or -1 if there are no rows
+     */
+    int currentIndex() const;
+
+    /**
+     * @brief Row at a position
+     * @return The index of the row, or -1 if there is no row at pos
+     */
+    int indexAt(const QPoint& pos) const;
+
+    /**
+     * @brief Bounds of a row within the widget
+     */
+    QRect rowRect(int index) const;
+
+    /**
+     * @brief Set the alignment of any displayed text
+     */
+    void setAlignment(Qt::Alignment alignment);
+
+    /**
+     * @brief Alignment of any displayed text
+     */
+    Qt::Alignment alignment() const;
+
+    /**
+     * @brief Set the slider components drawn for every row
+     */
+    void setSliderComponents(SliderEdit::SliderComponents components);
+
+    /**
+     * @brief Slider components drawn for every row
+     */
+    SliderEdit::SliderComponents sliderComponents() const;
+
+    /**
+     * @brief Set when valueChanging is emitted while a value is being changed
+     */
+    void setTrackingPolicy(SliderEdit::TrackingPolicy policy);
+
+    /**
+     * @brief Current tracking policy
+     */
+    SliderEdit::TrackingPolicy trackingPolicy() const;
+
+    /**
+     * @brief Set the interval used by SliderEdit::TrackThrottled and SliderEdit::TrackOnIdle
+     */
+    void setTrackingInterval(int msec);
+
+    /**
+     * @brief Current tracking interval
+     */
+    int trackingInterval() const;
+
+    /**
+     * @brief Overridden from QWidget
+     */
+    QSize sizeHint() const override;
+
+  Q_SIGNALS:
+    /**
+     * @param index The row which changed
+     * @param value The new value
+     *
+     * Emitted when the value of a row has changed
+     */
+    void valueChanged(int index, qreal value);
+
+    /**
+     * @param index The row which is changing
+     * @param value The new value
+     *
+     * Emitted while the value of a row is being changed
+     */
+    void valueChanging(int index, qreal value);
+
+  protected:
+    /**
+     * @brief Overridden from QWidget
+     */
+    void paintEvent(QPaintEvent*) override;
+
+    /**
+     * @brief Overridden from QWidget
+     */
+    void keyPressEvent(QKeyEvent*) override;
+
+    /**
+     * @brief Overridden from QWidget
+     */
+    void keyReleaseEvent(QKeyEvent*) override;
+
+    /**
+     * @brief Overridden from QWidget
+     */
+    void mousePressEvent(QMouseEvent*) override;
+
+    /**
+     * @brief Overridden from QWidget
+     */
+    void mouseMoveEvent(QMouseEvent*) override;
+
+    /**
+     * @brief Overridden from QWidget
+     */
+    void mouseReleaseEvent(QMouseEvent*) override;
+
+    /**
+     * @brief Overridden from QWidget
+     */
+    void mouseDoubleClickEvent(QMouseEvent*) override;
+
+    /**
+     * @brief Overridden from QWidget
+     */
+    void focusInEvent(QFocusEvent*) override;
+
+    /**
+     * @brief Overridden from QWidget
+     */
+    void focusOutEvent(QFocusEvent*) override;
+
+    /**
+     * @brief Overridden from QWidget
+     *
+     * Moves between rows while a value is edited as text.
+     */
+    bool focusNextPrevChild(bool next) override;
+
+    /**
+     * @brief Overridden from QWidget
+     */
+    void changeEvent(QEvent*) override;
+
+  private:
+    SliderEditGroupPrivate* const m_Impl;
+};
+
+#endif // SLIDEREDITGROUP_H
@@ -0,0 +1,100 @@
+/*
+ * Copyright (c) 2021 Victor Wåhlström
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ * claim that you wrote the original software. If you use this software
+ * in a product, an acknowledgment in the product documentation would be
+ * appreciated but is not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source
+ */
+
+
+#ifndef SLIDERHISTOGRAM_H
+#define SLIDERHISTOGRAM_H
+
+#include "ztwidgets_global.h"
+
+#include <QtGlobal>
+
+class SliderHistogramPrivate;
+
+/**
+ * @brief Distribution of a stream of samples, drawn on the track of a SliderEdit
+ *
+ * Samples are added by a producer on any thread and collected in a fixed size ring buffer, which never blocks and
+ * never allocates. Once per frame, the slider displaying the histogram moves pending samples into bins spread evenly
+ * over its track, so that the bins follow the value mapping of the slider. Old samples fade out according to the
+ * half-life.
+ *
+ * A histogram has a single producer and is displayed by a single slider at a time.
+ *
+ * See SliderEdit::setHistogram()
+ */
+class ZTWIDGETS_EXPORT SliderHistogram
+{
+    Q_DISABLE_COPY(SliderHistogram)
+
+  public:
+    /**
+     * @brief Construct an instance of SliderHistogram
+     * @param bins Number of bins along the track of the slider
+     * @param capacity Number of samples which can be pending between two frames. Rounded up to a power of two.
+     */
+    explicit SliderHistogram(int bins = 64, int capacity = 4096);
+
+    ~SliderHistogram();
+
+    /**
+     * @brief Add a sample. Can be called from the producer thread.
+     * @param value The sample. Samples outside the range of the slider are ignored.
+     * @return false if the sample was dropped because the buffer is full
+     */
+    bool addSample(qreal value);
+
+    /**
+     * @brief Set the time it takes for the weight of a sample to halve
+     * @param msec Half-life in milliseconds, or 0 to keep samples until clear() is called
+     *
+     * @note Must be called from the GUI thread
+     */
+    void setHalfLife(int msec);
+
+    /**
+     * @brief Current half-life
+     * @return Half-life in milliseconds
+     */
+    int halfLife() const;
+
+    /**
+     * @brief Number of bins
+     */
+    int binCount() const;
+
+    /**
+     * @brief Discard all binned samples
+     *
+     * Called by the slider when its range or value mapping changes, as the bins no longer match the track.
+     *
+     * @note Must be called from the GUI thread
+     */
+    void clear();
+
+  private:
+    friend class SliderEditPrivate;
+
+    SliderHistogramPrivate* const m_Impl;
+};
+
+#endif // SLIDERHISTOGRAM_H
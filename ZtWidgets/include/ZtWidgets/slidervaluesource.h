@@ -0,0 +1,71 @@
+/*
+ * Copyright (c) 2021 Victor Wåhlström
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ * claim that you wrote the original software. If you use this software
+ * in a product, an acknowledgment in the product documentation would be
+ * appreciated but is not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source
+ */
+
+
+#ifndef SLIDERVALUESOURCE_H
+#define SLIDERVALUESOURCE_H
+
+#include "ztwidgets_global.h"
+
+#include <QAtomicInteger>
+
+/**
+ * @brief A value slot written by a producer on any thread and displayed by a SliderEdit
+ *
+ * Writing never blocks and never posts events; a producer can update the value at any rate. Sliders showing the
+ * source read it once per frame and repaint only when it has changed, so intermediate values written between two
+ * frames are never seen.
+ *
+ * The slot holds a single value and is intended for a single producer. Concurrent writers do not corrupt it, but the
+ * last write wins.
+ *
+ * See SliderEdit::setValueSource()
+ */
+class ZTWIDGETS_EXPORT SliderValueSource
+{
+    Q_DISABLE_COPY(SliderValueSource)
+
+  public:
+    /**
+     * @brief Construct an instance of SliderValueSource
+     * @param value Initial value
+     */
+    explicit SliderValueSource(qreal value = 0.0);
+
+    /**
+     * @brief Set the value. Can be called from any thread.
+     * @param value The new value
+     */
+    void setValue(qreal value);
+
+    /**
+     * @brief Get the most recently written value. Can be called from any thread.
+     * @return The current value
+     */
+    qreal value() const;
+
+  private:
+    // the bit pattern of a double, which cannot be stored atomically by itself
+    QAtomicInteger<quint64> m_Bits;
+};
+
+#endif // SLIDERVALUESOURCE_H
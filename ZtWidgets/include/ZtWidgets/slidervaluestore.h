@@ -0,0 +1,211 @@
+/*
+ * Copyright (c) 2021 Victor Wåhlström
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ * claim that you wrote the original software. If you use this software
+ * in a product, an acknowledgment in the product documentation would be
+ * appreciated but is not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source
+ */
+
+
+#ifndef SLIDERVALUESTORE_H
+#define SLIDERVALUESTORE_H
+
+#include "slideredit.h"
+#include "ztwidgets_global.h"
+
+#include <QObject>
+#include <QVector>
+
+class SliderValueStorePrivate;
+
+/**
+ * @brief Values, ranges and display settings of a large number of sliders
+ *
+ * Each attribute is stored in a contiguous array indexed by row, rather than as one object per slider, so memory is
+ * proportional to the number of rows and bulk updates run through plain arrays. Rows start out with a value of 0, a
+ * range of [0, 1], a precision of 3 and a linear mapping.
+ *
+ * Every change results in a single rowsChanged notification for the range of rows it touched, regardless of how many
+ * rows that is.
+ *
+ * See SliderEditGrid
+ */
+class ZTWIDGETS_EXPORT SliderValueStore : public QObject
+{
+    Q_OBJECT
+
+    Q_DISABLE_COPY(SliderValueStore)
+
+    /**
+     * @brief This property holds the number of rows
+     */
+    Q_PROPERTY(int count READ count WRITE resize NOTIFY countChanged)
+
+    /**
+     * @brief This property holds the exponent used by rows mapped with SliderEdit::PowerScale
+     */
+    Q_PROPERTY(qreal mappingExponent READ mappingExponent WRITE setMappingExponent)
+
+  public:
+    /**
+     * @brief Construct an instance of SliderValueStore
+     * @param parent Parent object
+     */
+    explicit SliderValueStore(QObject* parent = nullptr);
+
+    virtual ~SliderValueStore();
+
+    /**
+     * @brief Change the number of rows
+     * @param count The new number of rows. Rows are added or removed at the end.
+     */
+    void resize(int count);
+
+    /**
+     * @brief Number of rows
+     */
+    int count() const;
+
+    /**
+     * @brief Value of a row
+     */
+    qreal value(int index) const;
+
+    /**
+     * @brief Set the value of a row. The value is clamped to the range of the row.
+     */
+    void setValue(int index, qreal value);
+
+    /**
+     * @brief Set the values of consecutive rows
+     * @param first The first row to set
+     * @param values Values for the rows, clamped to their ranges
+     * @param count Number of values. Values beyond the last row are ignored.
+     */
+    void setValues(int first, const qreal* values, int count);
+
+    /**
+     * @brief Set the values of consecutive rows
+     * @param first The first row to set
+     * @param values Values for the rows, clamped to their ranges
+     */
+    void setValues(int first, const QVector<qreal>& values);
+
+    /**
+     * @brief All values, indexed by row
+     */
+    const qreal* values() const;
+
+    /**
+     * @brief Set the range of a row. The value is clamped to the new range.
+     */
+    void setRange(int index, qreal minimum, qreal maximum);
+
+    /**
+     * @brief Set the ranges of consecutive rows. The values are clamped to the new ranges.
+     * @param first The first row to set
+     * @param minimums Minimum values for the rows
+     * @param maximums Maximum values for the rows
+     * @param count Number of ranges. Ranges beyond the last row are ignored.
+     */
+    void setRanges(int first, const qreal* minimums, const qreal* maximums, int count);
+
+    /**
+     * @brief Minimum value of a row
+     */
+    qreal minimum(int index) const;
+
+    /**
+     * @brief Maximum value of a row
+     */
+    qreal maximum(int index) const;
+
+    /**
+     * @brief All minimum values, indexed by row
+     */
+    const qreal* minimums() const;
+
+    /**
+     * @brief All maximum values, indexed by row
+     */
+    const qreal* maximums() const;
+
+    /**
+     * @brief Set the number of displayed decimals of a row
+     * @param precision Number of decimals, at most 255
+     */
+    void setPrecision(int index, quint32 precision);
+
+    /**
+     * @brief Number of displayed decimals of a row
+     */
+    quint32 precision(int index) const;
+
+    /**
+     * @brief Set how values are mapped on the slider of a row
+     * @param mapping The mapping. SliderEdit::CustomScale is not supported and behaves like SliderEdit::LinearScale.
+     */
+    void setValueMapping(int index, SliderEdit::ValueMapping mapping);
+
+    /**
+     * @brief Value mapping of a row
+     */
+    SliderEdit::ValueMapping valueMapping(int index) const;
+
+    /**
+     * @brief Set the exponent used by all rows mapped with SliderEdit::PowerScale
+     */
+    void setMappingExponent(qreal exponent);
+
+    /**
+     * @brief Exponent used by rows mapped with SliderEdit::PowerScale
+     */
+    qreal mappingExponent() const;
+
+    /**
+     * @brief Set the label of a row
+     *
+     * Storage for labels is only allocated once the first label is set.
+     */
+    void setLabel(int index, const QString& label);
+
+    /**
+     * @brief Label of a row
+     */
+    QString label(int index) const;
+
+  Q_SIGNALS:
+    /**
+     * @param first The first changed row
+     * @param last The last changed row
+     *
+     * Emitted when the value, range or display settings of any rows from first to last have changed
+     */
+    void rowsChanged(int first, int last);
+
+    /**
+     * @param count The new number of rows
+     *
+     * Emitted when the number of rows has changed
+     */
+    void countChanged(int count);
+
+  private:
+    SliderValueStorePrivate* const m_Impl;
+};
+
+#endif // SLIDERVALUESTORE_H
@@ -0,0 +1,119 @@
+/*
+ * Copyright (c) 2021 Victor Wåhlström
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ * claim that you wrote the original software. If you use this software
+ * in a product, an acknowledgment in the product documentation would be
+ * appreciated but is not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source
+ */
+
+
+#include "changetracker_p.h"
+
+#include <QTimer>
+
+ChangeTracker::ChangeTracker(std::function<void()> emit_changing)
+    : m_EmitChanging(emit_changing)
+    , m_Timer(nullptr)
+    , m_Interval(50)
+    , m_Policy(Always)
+    , m_Pending(false)
+{}
+
+ChangeTracker::~ChangeTracker()
+{
+    delete m_Timer;
+}
+
+void ChangeTracker::setPolicy(Policy policy)
+{
+    finish();
+    m_Policy = policy;
+
+    // the timer is only needed by time based policies, so most widgets never allocate one
+    if (!m_Timer && (m_Policy == Throttled || m_Policy == OnIdle))
+    {
+        m_Timer = new QTimer;
+        m_Timer->setSingleShot(true);
+        QObject::connect(m_Timer, &QTimer::timeout, [this]() { flush(); });
+    }
+}
+
+ChangeTracker::Policy ChangeTracker::policy() const
+{
+    return m_Policy;
+}
+
+void ChangeTracker::setInterval(int msec)
+{
+    m_Interval = qMax(0, msec);
+}
+
+int ChangeTracker::interval() const
+{
+    return m_Interval;
+}
+
+void ChangeTracker::changing()
+{
+    switch (m_Policy)
+    {
+        case Always:
+            m_EmitChanging();
+            break;
+        case Throttled:
+        {
+            const qint64 elapsed = m_LastEmit.isValid() ? m_LastEmit.elapsed() : m_Interval;
+            if (elapsed >= m_Interval)
+            {
+                m_Timer->stop();
+                m_Pending = true;
+                flush();
+            }
+            else
+            {
+                m_Pending = true;
+                if (!m_Timer->isActive())
+                    m_Timer->start(m_Interval - static_cast<int>(elapsed));
+            }
+        }
+        break;
+        case OnIdle:
+            m_Pending = true;
+            m_Timer->start(m_Interval);
+            break;
+        case OnRelease:
+            break;
+    }
+}
+
+void ChangeTracker::finish()
+{
+    m_Pending = false;
+    m_LastEmit.invalidate();
+    if (m_Timer)
+        m_Timer->stop();
+}
+
+void ChangeTracker::flush()
+{
+    if (!m_Pending)
+        return;
+
+    m_Pending = false;
+    m_LastEmit.start();
+    m_EmitChanging();
+}
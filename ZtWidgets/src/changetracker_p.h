@@ -0,0 +1,89 @@
+/*
+ * Copyright (c) 2021 Victor Wåhlström
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ * claim that you wrote the original software. If you use this software
+ * in a product, an acknowledgment in the product documentation would be
+ * appreciated but is not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source
+ */
+
+
+#ifndef CHANGETRACKER_H
+#define CHANGETRACKER_H
+
+#include <QElapsedTimer>
+
+#include <functional>
+
+class QTimer;
+
+/**
+ * @brief Decides when an ongoing change should be reported
+ *
+ * Widgets report every intermediate change to the tracker, which forwards them to the emitter according to the
+ * active policy. The final change is always reported by the widget itself, after calling finish().
+ */
+class ChangeTracker
+{
+    Q_DISABLE_COPY(ChangeTracker)
+
+  public:
+    /**
+     * @brief Tracking policies. Mirrors SliderEdit::TrackingPolicy and ColorPicker::TrackingPolicy.
+     */
+    enum Policy
+    {
+        Always    = 0, ///< Report every change
+        Throttled = 1, ///< Report at most one change per interval
+        OnIdle    = 2, ///< Report a change once no further changes have been made for one interval
+        OnRelease = 3, ///< Never report intermediate changes
+    };
+
+    /**
+     * @brief Constructor
+     * @param emit_changing Called whenever an intermediate change should be reported
+     */
+    explicit ChangeTracker(std::function<void()> emit_changing);
+    ~ChangeTracker();
+
+    void setPolicy(Policy policy);
+    Policy policy() const;
+
+    void setInterval(int msec);
+    int interval() const;
+
+    /**
+     * @brief Notify the tracker of an intermediate change
+     */
+    void changing();
+
+    /**
+     * @brief End the current interaction, discarding any unreported intermediate change
+     */
+    void finish();
+
+  private:
+    void flush();
+
+    std::function<void()> m_EmitChanging;
+    QTimer* m_Timer;
+    QElapsedTimer m_LastEmit;
+    int m_Interval;
+    Policy m_Policy;
+    bool m_Pending;
+};
+
+#endif // CHANGETRACKER_H
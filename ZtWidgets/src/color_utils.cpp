@@ -33,7 +33,7 @@ void drawCheckerboard(QPainter& painter, const QRect& rect, unsigned int size)
 
     painter.save();
     painter.fillRect(rect, color1);
-    QRect square(0, 0, size, size);
+    QRect square(rect.x(), rect.y(), size, size);
     quint32 step_x(size * 2);
     quint32 step_y(size);
     bool odd = true;
@@ -45,7 +45,7 @@ void drawCheckerboard(QPainter& painter, const QRect& rect, unsigned int size)
             square.moveLeft(square.left() + step_x);
         }
 
-        square.moveLeft(0);
+        square.moveLeft(rect.x());
         if (odd)
         {
             square.moveLeft(square.left() + step_x * 0.5);
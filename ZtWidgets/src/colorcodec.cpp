@@ -0,0 +1,451 @@
+/*
+ * Copyright (c) 2021 Victor Wåhlström
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ * claim that you wrote the original software. If you use this software
+ * in a product, an acknowledgment in the product documentation would be
+ * appreciated but is not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source
+ */
+
+#include "colorcodec_p.h"
+
+#include <QColor>
+#include <QtMath>
+
+static const char S_HEX_DIGITS[] = "0123456789ABCDEF";
+
+// hexadecimal value of each ASCII character, or -1
+static const qint8 S_HEX_VALUES[128] = {
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+     0,  1,  2,  3,  4,  5,  6,  7,  8,  9, -1, -1, -1, -1, -1, -1,
+    -1, 10, 11, 12, 13, 14, 15, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, 10, 11, 12, 13, 14, 15, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+};
+
+static constexpr const qint64 S_POW10[] = { 1, 10, 100, 1000, 10000, 100000, 1000000 };
+
+// number of decimals used for fractional values
+static constexpr const int S_DECIMALS = 3;
+
+static int hexValue(QChar c)
+{
+    const ushort u = c.unicode();
+    return u < 128 ? S_HEX_VALUES[u] : -1;
+}
+
+//! @cond Doxygen_Suppress
+class ColorTextWriter
+{
+  public:
+    explicit ColorTextWriter(QChar* out)
+        : m_Out(out)
+        , m_Length(0)
+    {}
+
+    int length() const { return m_Length; }
+
+    void put(char c) { m_Out[m_Length++] = QLatin1Char(c); }
+
+    void put(const char* s)
+    {
+        while (*s)
+            put(*s++);
+    }
+
+    void putHex(int value)
+    {
+        put(S_HEX_DIGITS[(value >> 4) & 0xF]);
+        put(S_HEX_DIGITS[value & 0xF]);
+    }
+
+    void putInt(qint64 value)
+    {
+        if (value < 0)
+        {
+            put('-');
+            value = -value;
+        }
+
+        char digits[20];
+        int n = 0;
+        do
+        {
+            digits[n++] = static_cast<char>('0' + value % 10);
+            value /= 10;
+        } while (value);
+
+        while (n)
+            put(digits[--n]);
+    }
+
+    void putFixed(qreal value)
+    {
+        const qint64 scale  = S_POW10[S_DECIMALS];
+        const qint64 scaled = qRound64(qAbs(value) * scale);
+        if (value < 0 && scaled)
+            put('-');
+
+        putInt(scaled / scale);
+        put('.');
+
+        qint64 fraction = scaled % scale;
+        for (int i = S_DECIMALS - 1; i >= 0; --i)
+        {
+            put(static_cast<char>('0' + fraction / S_POW10[i]));
+            fraction %= S_POW10[i];
+        }
+    }
+
+  private:
+    QChar* const m_Out;
+    int m_Length;
+};
+
+class ColorTextReader
+{
+  public:
+    explicit ColorTextReader(QStringView text)
+        : m_Pos(text.data())
+        , m_End(text.data() + text.size())
+    {}
+
+    bool atEnd()
+    {
+        skipSpace();
+        return m_Pos == m_End;
+    }
+
+    ushort peek() const { return m_Pos < m_End ? m_Pos->unicode() : 0; }
+
+    void skipSpace()
+    {
+        while (m_Pos < m_End && m_Pos->isSpace())
+            ++m_Pos;
+    }
+
+    bool consume(char c)
+    {
+        skipSpace();
+        if (peek() != static_cast<ushort>(c))
+            return false;
+
+        ++m_Pos;
+        return true;
+    }
+
+    bool consumeWord(const char* word)
+    {
+        skipSpace();
+        const QChar* pos = m_Pos;
+        for (; *word; ++word, ++pos)
+        {
+            if (pos == m_End || pos->toLower().unicode() != static_cast<ushort>(*word))
+                return false;
+        }
+
+        m_Pos = pos;
+        return true;
+    }
+
+    int readHexDigits(int* values, int max_count)
+    {
+        skipSpace();
+        int n = 0;
+        while (m_Pos < m_End && n < max_count)
+        {
+            const int v = hexValue(*m_Pos);
+            if (v < 0)
+                break;
+
+            values[n++] = v;
+            ++m_Pos;
+        }
+
+        // reject input with more digits than expected
+        return m_Pos < m_End && hexValue(*m_Pos) >= 0 ? -1 : n;
+    }
+
+    bool readNumber(qreal* value, bool* percent)
+    {
+        skipSpace();
+        const bool negative = consume('-');
+        if (!negative)
+            consume('+');
+
+        qint64 mantissa = 0;
+        int digits      = 0;
+        int decimals    = 0;
+        bool fraction   = false;
+        for (; m_Pos < m_End; ++m_Pos)
+        {
+            const ushort u = m_Pos->unicode();
+            if (u == '.' && !fraction)
+            {
+                fraction = true;
+            }
+            else if (u >= '0' && u <= '9')
+            {
+                // ignore digits beyond what can be represented
+                if (digits < 15)
+                {
+                    mantissa = mantissa * 10 + (u - '0');
+                    decimals += fraction ? 1 : 0;
+                }
+                else if (!fraction)
+                {
+                    return false;
+                }
+                ++digits;
+            }
+            else
+            {
+                break;
+            }
+        }
+
+        if (!digits)
+            return false;
+
+        qreal v = static_cast<qreal>(mantissa);
+        while (decimals > 0)
+        {
+            const int n = qMin(decimals, 6);
+            v /= S_POW10[n];
+            decimals -= n;
+        }
+
+        *value   = negative ? -v : v;
+        *percent = consume('%');
+        return true;
+    }
+
+    // reads up to four comma, space or slash separated numbers enclosed in the given brackets
+    int readArguments(qreal* values, bool* percent, char open, char close, bool brackets_required)
+    {
+        const bool has_open = consume(open);
+        if (brackets_required && !has_open)
+            return -1;
+
+        int n = 0;
+        while (n < 4)
+        {
+            if (n > 0 && !consume(','))
+                consume('/');
+
+            if (!readNumber(&values[n], &percent[n]))
+                break;
+            ++n;
+        }
+
+        if (has_open && !consume(close))
+            return -1;
+
+        return atEnd() ? n : -1;
+    }
+
+  private:
+    const QChar* m_Pos;
+    const QChar* const m_End;
+};
+//! @endcond
+
+static int toChannel(qreal value, bool percent)
+{
+    return qBound(0, qRound(percent ? value * 2.55 : value), 255);
+}
+
+static qreal toUnit(qreal value, bool percent)
+{
+    return qBound(0.0, percent ? value * 0.01 : value, 1.0);
+}
+
+static bool parseHex(ColorTextReader& reader, QColor* color, bool prefixed)
+{
+    int v[8];
+    const int n = reader.readHexDigits(v, 8);
+    if (!reader.atEnd())
+        return false;
+
+    switch (n)
+    {
+        case 3:
+            if (!prefixed)
+                return false;
+            color->setRgb(v[0] * 17, v[1] * 17, v[2] * 17);
+            return true;
+        case 6:
+            color->setRgb(v[0] << 4 | v[1], v[2] << 4 | v[3], v[4] << 4 | v[5]);
+            return true;
+        case 8:
+            color->setRgb(v[2] << 4 | v[3], v[4] << 4 | v[5], v[6] << 4 | v[7], v[0] << 4 | v[1]);
+            return true;
+        default:
+            return false;
+    }
+}
+
+static bool parseRgb(ColorTextReader& reader, QColor* color)
+{
+    qreal v[4];
+    bool p[4];
+    const int n = reader.readArguments(v, p, '(', ')', true);
+    if (n != 3 && n != 4)
+        return false;
+
+    color->setRgb(toChannel(v[0], p[0]), toChannel(v[1], p[1]), toChannel(v[2], p[2]));
+    if (n == 4)
+        color->setAlphaF(toUnit(v[3], p[3]));
+
+    return true;
+}
+
+static bool parseHsl(ColorTextReader& reader, QColor* color)
+{
+    qreal v[4];
+    bool p[4];
+    const int n = reader.readArguments(v, p, '(', ')', true);
+    if (n != 3 && n != 4)
+        return false;
+
+    qreal hue = v[0] - 360.0 * qFloor(v[0] / 360.0);
+    // saturation and lightness are always percentages, with or without the '%' sign
+    color->setHslF(hue / 360.0,
+                   toUnit(v[1], true),
+                   toUnit(v[2], true),
+                   n == 4 ? toUnit(v[3], p[3]) : 1.0);
+    return true;
+}
+
+static bool parseTuple(ColorTextReader& reader, QColor* color)
+{
+    qreal v[4];
+    bool p[4];
+    const int n = reader.peek() == '[' ? reader.readArguments(v, p, '[', ']', false)
+                                       : reader.readArguments(v, p, '(', ')', false);
+    if (n != 3 && n != 4)
+        return false;
+
+    color->setRgbF(toUnit(v[0], p[0]), toUnit(v[1], p[1]), toUnit(v[2], p[2]), n == 4 ? toUnit(v[3], p[3]) : 1.0);
+    return true;
+}
+
+int ColorCodec::format(const QColor& color, Format format, QChar* out)
+{
+    const QColor c = color.spec() == QColor::Rgb ? color : color.toRgb();
+    ColorTextWriter w(out);
+
+    switch (format)
+    {
+        case HexRgbShort:
+            w.put('#');
+            w.put(S_HEX_DIGITS[(c.red() * 15 + 127) / 255]);
+            w.put(S_HEX_DIGITS[(c.green() * 15 + 127) / 255]);
+            w.put(S_HEX_DIGITS[(c.blue() * 15 + 127) / 255]);
+            break;
+        case HexRgb:
+            w.put('#');
+            w.putHex(c.red());
+            w.putHex(c.green());
+            w.putHex(c.blue());
+            break;
+        case HexArgb:
+            w.put('#');
+            w.putHex(c.alpha());
+            w.putHex(c.red());
+            w.putHex(c.green());
+            w.putHex(c.blue());
+            break;
+        case CssRgb:
+            w.put(c.alpha() == 255 ? "rgb(" : "rgba(");
+            w.putInt(c.red());
+            w.put(", ");
+            w.putInt(c.green());
+            w.put(", ");
+            w.putInt(c.blue());
+            if (c.alpha() != 255)
+            {
+                w.put(", ");
+                w.putFixed(c.alphaF());
+            }
+            w.put(')');
+            break;
+        case CssHsl:
+            w.put(c.alpha() == 255 ? "hsl(" : "hsla(");
+            w.putInt(qMax(0, c.hslHue()));
+            w.put(", ");
+            w.putInt(qRound(c.hslSaturationF() * 100));
+            w.put("%, ");
+            w.putInt(qRound(c.lightnessF() * 100));
+            w.put('%');
+            if (c.alpha() != 255)
+            {
+                w.put(", ");
+                w.putFixed(c.alphaF());
+            }
+            w.put(')');
+            break;
+        case FloatTuple:
+            w.put('(');
+            w.putFixed(c.redF());
+            w.put(", ");
+            w.putFixed(c.greenF());
+            w.put(", ");
+            w.putFixed(c.blueF());
+            w.put(", ");
+            w.putFixed(c.alphaF());
+            w.put(')');
+            break;
+    }
+
+    return w.length();
+}
+
+QString ColorCodec::toString(const QColor& color, Format format)
+{
+    QChar buffer[MaxLength];
+    return QString(buffer, ColorCodec::format(color, format, buffer));
+}
+
+bool ColorCodec::parse(QStringView text, QColor* color)
+{
+    ColorTextReader reader(text);
+    if (reader.atEnd())
+        return false;
+
+    if (reader.consume('#'))
+        return parseHex(reader, color, true);
+
+    // rgba and hsla must be tested before their shorter counterparts
+    if (reader.consumeWord("rgba") || reader.consumeWord("rgb"))
+        return parseRgb(reader, color);
+
+    if (reader.consumeWord("hsla") || reader.consumeWord("hsl"))
+        return parseHsl(reader, color);
+
+    ColorTextReader hex_reader = reader;
+    QColor hex_color;
+    if (parseHex(hex_reader, &hex_color, false))
+    {
+        *color = hex_color;
+        return true;
+    }
+
+    return parseTuple(reader, color);
+}
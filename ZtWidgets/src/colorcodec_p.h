@@ -0,0 +1,83 @@
+/*
+ * Copyright (c) 2021 Victor Wåhlström
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ * claim that you wrote the original software. If you use this software
+ * in a product, an acknowledgment in the product documentation would be
+ * appreciated but is not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source
+ */
+
+#ifndef COLORCODEC_H
+#define COLORCODEC_H
+
+#include <QString>
+#include <QStringView>
+
+class QColor;
+
+/**
+ * @brief Converts colors to and from text without temporary allocations
+ *
+ * Supported formats are \#RGB, \#RRGGBB and \#AARRGGBB, CSS rgb()/rgba() and hsl()/hsla(), and tuples of floating
+ * point values in the range [0, 1] on the form (r, g, b, a).
+ */
+class ColorCodec
+{
+  public:
+    /**
+     * @brief Text formats
+     */
+    enum Format
+    {
+        HexRgbShort, ///< \#RGB, using the closest 4 bit value of each channel
+        HexRgb,      ///< \#RRGGBB
+        HexArgb,     ///< \#AARRGGBB
+        CssRgb,      ///< rgb(r, g, b), or rgba(r, g, b, a) if the color is not opaque
+        CssHsl,      ///< hsl(h, s%, l%), or hsla(h, s%, l%, a) if the color is not opaque
+        FloatTuple,  ///< (r, g, b, a)
+    };
+
+    /**
+     * @brief Number of characters needed to hold the output of format()
+     */
+    static constexpr const int MaxLength = 32;
+
+    /**
+     * @brief Format a color
+     * @param color The color to format
+     * @param format The text format
+     * @param out Output buffer. Must be able to hold MaxLength characters.
+     * @return The number of characters written to the buffer
+     */
+    static int format(const QColor& color, Format format, QChar* out);
+
+    /**
+     * @brief Convenience function returning the output of format() as a string
+     */
+    static QString toString(const QColor& color, Format format);
+
+    /**
+     * @brief Parse a color in any of the supported formats
+     * @param text Text to parse. Leading and trailing whitespace is ignored.
+     * @param color Receives the parsed color. Left untouched if the text could not be parsed.
+     * @return true if the text could be parsed
+     *
+     * Hex colors with 6 or 8 digits are accepted without a leading '#'.
+     */
+    static bool parse(QStringView text, QColor* color);
+};
+
+#endif // COLORCODEC_H
@@ -22,7 +22,7 @@
 
 #include "colordisplay_p.h"
 
-#include "color_utils_p.h"
+#include "swatchpainter_p.h"
 
 #include <QtGui/QPaintEvent>
 #include <QtGui/QPainter>
@@ -78,9 +78,7 @@ void ColorDisplay::paintEvent(QPaintEvent*)
     QPainter painter(this);
     painter.save();
 
-    painter.setClipRect(rect());
-    drawCheckerboard(painter, rect(), 5);
-    painter.fillRect(rect(), m_Impl->m_Color);
+    SwatchPainter::drawSwatch(painter, rect(), m_Impl->m_Color);
 
     painter.restore();
 }
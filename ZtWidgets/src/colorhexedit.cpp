@@ -20,38 +20,30 @@
  * 3. This notice may not be removed or altered from any source
  */
 
+#include "colorcodec_p.h"
 #include "colorhexedit_p.h"
 
+#include <QtCore/QEvent>
 #include <QtCore/QSize>
 #include <QtCore/QString>
 #include <QtCore/Qt>
+#include <QtGui/QClipboard>
 #include <QtGui/QColor>
 #include <QtGui/QFont>
 #include <QtGui/QFontMetrics>
+#include <QtGui/QGuiApplication>
+#include <QtGui/QKeyEvent>
 #include <QtWidgets/QHBoxLayout>
 #include <QtWidgets/QLabel>
 #include <QtWidgets/QLineEdit>
 #include <QtWidgets/QStyle>
 #include <QtWidgets/QStyleOptionFrame>
 
-static QString colorToString(const QColor& color, bool include_alpha)
+// formats the color without the leading '#' into a buffer of ColorCodec::MaxLength characters
+static QStringView colorToString(const QColor& color, bool include_alpha, QChar* buffer)
 {
-    QLatin1Char fill('0');
-    if (include_alpha)
-    {
-        return QString("%1%2%3%4")
-            .arg(color.alpha(), 2, 16, fill)
-            .arg(color.red(), 2, 16, fill)
-            .arg(color.green(), 2, 16, fill)
-            .arg(color.blue(), 2, 16, fill)
-            .toUpper();
-    }
-
-    return QString("%1%2%3")
-        .arg(color.red(), 2, 16, fill)
-        .arg(color.green(), 2, 16, fill)
-        .arg(color.blue(), 2, 16, fill)
-        .toUpper();
+    const int length = ColorCodec::format(color, include_alpha ? ColorCodec::HexArgb : ColorCodec::HexRgb, buffer);
+    return QStringView(buffer + 1, length - 1);
 }
 
 //! @cond Doxygen_Suppress
@@ -64,11 +56,23 @@ class ColorHexEditPrivate
 
     int editWidth() const;
     void refresh();
+    void refreshInputMask();
+    void refreshGeometry();
+    void setText(const QColor& color);
+    bool paste();
 
     QColor m_Color;
     QLineEdit* m_LineEdit;
+    // the state the current input mask and geometry were computed for
+    QFont m_GeometryFont;
+    const QStyle* m_GeometryStyle;
+    qreal m_GeometryDevicePixelRatio;
     bool m_DisplayAlpha : 1;
     bool m_Modified : 1;
+    bool m_InputMaskAlpha : 1;
+    bool m_InputMaskValid : 1;
+    bool m_GeometryAlpha : 1;
+    bool m_GeometryValid : 1;
 
   private:
     ColorHexEdit* const m_ColorHexEdit;
@@ -77,8 +81,14 @@ class ColorHexEditPrivate
 ColorHexEditPrivate::ColorHexEditPrivate(ColorHexEdit* hex_edit)
     : m_Color(Qt::white)
     , m_LineEdit(nullptr)
+    , m_GeometryStyle(nullptr)
+    , m_GeometryDevicePixelRatio(0.0)
     , m_DisplayAlpha(true)
     , m_Modified(false)
+    , m_InputMaskAlpha(false)
+    , m_InputMaskValid(false)
+    , m_GeometryAlpha(false)
+    , m_GeometryValid(false)
     , m_ColorHexEdit(hex_edit)
 {}
 
@@ -105,6 +115,15 @@ int ColorHexEditPrivate::editWidth() const
 
 void ColorHexEditPrivate::refresh()
 {
+    refreshInputMask();
+    refreshGeometry();
+}
+
+void ColorHexEditPrivate::refreshInputMask()
+{
+    if (m_InputMaskValid && m_InputMaskAlpha == m_DisplayAlpha)
+        return;
+
     if (m_DisplayAlpha)
     {
         m_LineEdit->setMaxLength(8);
@@ -122,9 +141,61 @@ void ColorHexEditPrivate::refresh()
     }
 
     m_LineEdit->setAlignment(Qt::AlignCenter);
+    setText(m_Color);
+
+    m_InputMaskAlpha = m_DisplayAlpha;
+    m_InputMaskValid = true;
+}
+
+void ColorHexEditPrivate::refreshGeometry()
+{
+    // setFixedWidth() triggers a relayout, so only recompute the width if something affecting it has changed
+    const QFont font        = m_LineEdit->font();
+    const QStyle* style     = m_LineEdit->style();
+    const qreal pixel_ratio = m_LineEdit->devicePixelRatioF();
+    if (m_GeometryValid && m_GeometryAlpha == m_DisplayAlpha && m_GeometryStyle == style &&
+        qFuzzyCompare(m_GeometryDevicePixelRatio, pixel_ratio) && m_GeometryFont == font)
+    {
+        return;
+    }
 
     m_LineEdit->setFixedWidth(editWidth());
-    m_LineEdit->setText(colorToString(m_Color, m_ColorHexEdit->displayAlpha()));
+
+    m_GeometryFont             = font;
+    m_GeometryStyle            = style;
+    m_GeometryDevicePixelRatio = pixel_ratio;
+    m_GeometryAlpha            = m_DisplayAlpha;
+    m_GeometryValid            = true;
+}
+
+void ColorHexEditPrivate::setText(const QColor& color)
+{
+    QChar buffer[ColorCodec::MaxLength];
+    m_LineEdit->setText(colorToString(color, m_DisplayAlpha, buffer).toString());
+}
+
+bool ColorHexEditPrivate::paste()
+{
+    // the input mask would mangle anything but bare hex digits, so parse the clipboard contents ourselves
+    const QClipboard* clipboard = QGuiApplication::clipboard();
+    if (!clipboard)
+        return false;
+
+    QColor color;
+    if (!ColorCodec::parse(clipboard->text(), &color))
+        return false;
+
+    if (!m_DisplayAlpha)
+        color.setAlpha(255);
+
+    m_Modified = false;
+    if (color != m_Color)
+    {
+        m_ColorHexEdit->updateColor(color);
+        Q_EMIT m_ColorHexEdit->colorChanged(m_Color);
+    }
+
+    return true;
 }
 
 //! @endcond
@@ -161,18 +232,20 @@ ColorHexEdit::ColorHexEdit(QWidget* parent)
             m_Impl->m_LineEdit->setCursorPosition(pos);
         }
 
-        if (m_Impl->m_LineEdit->text() == colorToString(m_Impl->m_Color, displayAlpha()))
+        QChar buffer[ColorCodec::MaxLength];
+        if (QStringView(m_Impl->m_LineEdit->text()) == colorToString(m_Impl->m_Color, displayAlpha(), buffer))
         {
             return;
         }
 
         m_Impl->m_Modified = true;
-        m_Impl->m_Color.setNamedColor("#" + text);
+        ColorCodec::parse(m_Impl->m_LineEdit->text(), &m_Impl->m_Color);
         Q_EMIT colorChanging(m_Impl->m_Color);
     };
 
     connect(m_Impl->m_LineEdit, &QLineEdit::textEdited, this, on_text_edited);
     connect(m_Impl->m_LineEdit, &QLineEdit::editingFinished, this, on_editing_finished);
+    m_Impl->m_LineEdit->installEventFilter(this);
 
     layout->addWidget(m_Impl->m_LineEdit);
     setLayout(layout);
@@ -185,16 +258,40 @@ ColorHexEdit::~ColorHexEdit()
 
 void ColorHexEdit::showEvent(QShowEvent* event)
 {
-    // refresh the UI here as fonts, styles, and other things affecting this widget may have changed
+    // fonts, styles, and other things affecting this widget may have changed while it was hidden
     m_Impl->refresh();
     QWidget::showEvent(event);
 }
 
+void ColorHexEdit::changeEvent(QEvent* event)
+{
+    if (event->type() == QEvent::FontChange || event->type() == QEvent::StyleChange)
+    {
+        // a new style may be allocated where the old one used to be, so don't rely on comparing pointers
+        m_Impl->m_GeometryValid = false;
+        if (isVisible())
+            m_Impl->refreshGeometry();
+    }
+
+    QWidget::changeEvent(event);
+}
+
+bool ColorHexEdit::eventFilter(QObject* watched, QEvent* event)
+{
+    if (watched == m_Impl->m_LineEdit && event->type() == QEvent::KeyPress &&
+        static_cast<QKeyEvent*>(event)->matches(QKeySequence::Paste) && m_Impl->paste())
+    {
+        return true;
+    }
+
+    return QWidget::eventFilter(watched, event);
+}
+
 void ColorHexEdit::updateColor(const QColor& color)
 {
     if (m_Impl->m_Color != color)
     {
-        m_Impl->m_LineEdit->setText(colorToString(color, displayAlpha()));
+        m_Impl->setText(color);
         m_Impl->m_Color = color;
         update();
     }
@@ -202,6 +299,9 @@ void ColorHexEdit::updateColor(const QColor& color)
 
 void ColorHexEdit::setDisplayAlpha(bool visible)
 {
+    if (m_Impl->m_DisplayAlpha == visible && m_Impl->m_InputMaskValid)
+        return;
+
     m_Impl->m_DisplayAlpha = visible;
     m_Impl->refresh();
 }
@@ -89,6 +89,18 @@ class ColorHexEdit : public QWidget
      */
     void showEvent(QShowEvent* event) override;
 
+    /**
+     * @brief Overridden from QWidget
+     */
+    void changeEvent(QEvent* event) override;
+
+    /**
+     * @brief Overridden from QObject
+     *
+     * Intercepts paste in the line edit, so that colors in any format supported by ColorCodec can be pasted.
+     */
+    bool eventFilter(QObject* watched, QEvent* event) override;
+
   Q_SIGNALS:
     /**
      * @param color The new color
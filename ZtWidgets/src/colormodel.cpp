@@ -0,0 +1,95 @@
+/*
+ * Copyright (c) 2021 Victor Wåhlström
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ * claim that you wrote the original software. If you use this software
+ * in a product, an acknowledgment in the product documentation would be
+ * appreciated but is not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source
+ */
+
+#include <ZtWidgets/colormodel.h>
+
+//! @cond Doxygen_Suppress
+class ColorModelPrivate
+{
+    Q_DISABLE_COPY(ColorModelPrivate)
+
+  public:
+    explicit ColorModelPrivate(const QColor& color);
+
+    QColor m_Color;
+    quint64 m_Version;
+    bool m_Changing : 1;
+};
+
+ColorModelPrivate::ColorModelPrivate(const QColor& color)
+    : m_Color(color)
+    , m_Version(0)
+    , m_Changing(false)
+{}
+//! @endcond
+
+ColorModel::ColorModel(QObject* parent)
+    : QObject(parent)
+    , m_Impl(new ColorModelPrivate(Qt::white))
+{}
+
+ColorModel::ColorModel(const QColor& color, QObject* parent)
+    : QObject(parent)
+    , m_Impl(new ColorModelPrivate(color))
+{}
+
+ColorModel::~ColorModel()
+{
+    delete m_Impl;
+}
+
+const QColor& ColorModel::color() const
+{
+    return m_Impl->m_Color;
+}
+
+quint64 ColorModel::version() const
+{
+    return m_Impl->m_Version;
+}
+
+void ColorModel::setColor(const QColor& color)
+{
+    // a color committed after an interactive change must be reported even if it matches the last intermediate color
+    if (m_Impl->m_Color == color && !m_Impl->m_Changing)
+        return;
+
+    if (m_Impl->m_Color != color)
+    {
+        m_Impl->m_Color = color;
+        ++m_Impl->m_Version;
+    }
+
+    m_Impl->m_Changing = false;
+    Q_EMIT colorChanged(m_Impl->m_Color);
+}
+
+void ColorModel::setChangingColor(const QColor& color)
+{
+    if (m_Impl->m_Color == color)
+        return;
+
+    m_Impl->m_Color    = color;
+    m_Impl->m_Changing = true;
+    ++m_Impl->m_Version;
+    Q_EMIT colorChanging(m_Impl->m_Color);
+}
@@ -20,15 +20,59 @@
  * 3. This notice may not be removed or altered from any source
  */
 
+#include "changetracker_p.h"
+#include "colorcodec_p.h"
 #include "colordisplay_p.h"
 #include "colorhexedit_p.h"
 #include "colorpickerpopup_p.h"
 #include "huesaturationwheel_p.h"
+#include "styleresources_p.h"
+#include "swatchpainter_p.h"
+#include <ZtWidgets/colormodel.h>
 #include <ZtWidgets/colorpicker.h>
+#include <ZtWidgets/colorpreviewchannel.h>
 #include <ZtWidgets/slideredit.h>
 
-#include <QFontDatabase>
+#include <QClipboard>
+#include <QDragEnterEvent>
+#include <QDropEvent>
+#include <QGuiApplication>
 #include <QHBoxLayout>
+#include <QKeyEvent>
+#include <QMimeData>
+#include <QPainter>
+#include <QPointer>
+#include <QStyleOption>
+
+// formats the color including the leading '#' into a buffer of ColorCodec::MaxLength characters
+static QStringView colorToHex(const QColor& color, bool include_alpha, QChar* buffer)
+{
+    const int length = ColorCodec::format(color, include_alpha ? ColorCodec::HexArgb : ColorCodec::HexRgb, buffer);
+    return QStringView(buffer, length);
+}
+
+static bool colorFromMimeData(const QMimeData* mime_data, QColor* color)
+{
+    if (!mime_data)
+        return false;
+
+    if (mime_data->hasColor())
+    {
+        *color = qvariant_cast<QColor>(mime_data->colorData());
+        return color->isValid();
+    }
+
+    return mime_data->hasText() && ColorCodec::parse(mime_data->text(), color);
+}
+
+static bool isHexDigit(const QKeyEvent* event)
+{
+    if (event->modifiers() & (Qt::ControlModifier | Qt::AltModifier | Qt::MetaModifier))
+        return false;
+
+    const int key = event->key();
+    return (key >= Qt::Key_0 && key <= Qt::Key_9) || (key >= Qt::Key_A && key <= Qt::Key_F);
+}
 
 //! @cond Doxygen_Suppress
 
@@ -37,84 +81,285 @@ class ColorPickerPrivate
     Q_DISABLE_COPY(ColorPickerPrivate)
 
   public:
-    explicit ColorPickerPrivate();
+    explicit ColorPickerPrivate(ColorPicker* color_picker);
+
+    void syncFromModel();
+    void commitColor(const QColor& color);
+    void previewColor(const QColor& color);
+    void emitColorChanging();
+    void showPopup();
+
+    void createChildren();
+    void destroyChildren();
+
+    QRect swatchRect() const;
+    QRect textRect() const;
+    QPoint textOrigin(const QString& text) const;
+    void beginEdit(int x);
+    void endEdit();
+    void cancelEdit();
+    bool isEditing() const;
+
+    void copyColor() const;
+    bool importColor(const QMimeData* mime_data);
 
     ColorHexEdit* m_Hex;
     ColorDisplay* m_Display;
     ColorPickerPopup* m_Popup;
+    ChangeTracker m_Tracker;
+    QPointer<ColorModel> m_Model;
+    QPointer<ColorPreviewChannel> m_PreviewChannel;
+    quint64 m_ModelVersion;
     QColor m_Color;
+    QColor m_EditColor;
+    QString m_EditText;
+    int m_EditCursorPos;
     ColorPicker::EditType m_EditType;
     bool m_DisplayAlpha : 1;
+    bool m_Lightweight : 1;
+    bool m_EditModified : 1;
+
+  private:
+    ColorPicker* const m_ColorPicker;
 };
 
-ColorPickerPrivate::ColorPickerPrivate()
+ColorPickerPrivate::ColorPickerPrivate(ColorPicker* color_picker)
     : m_Hex(nullptr)
     , m_Display(nullptr)
     , m_Popup(nullptr)
+    , m_Tracker([this]() { emitColorChanging(); })
+    , m_ModelVersion(0)
     , m_Color(Qt::white)
+    , m_EditCursorPos(0)
     , m_EditType(ColorPicker::Float)
     , m_DisplayAlpha(true)
+    , m_Lightweight(false)
+    , m_EditModified(false)
+    , m_ColorPicker(color_picker)
 {}
 
-//! @endcond
+void ColorPickerPrivate::syncFromModel()
+{
+    if (!m_Model || m_Model->version() == m_ModelVersion)
+        return;
 
-ColorPicker::ColorPicker(QWidget* parent)
-    : QWidget(parent)
-    , m_Impl(new ColorPickerPrivate())
+    m_ModelVersion = m_Model->version();
+    m_ColorPicker->updateColor(m_Model->color());
+}
+
+void ColorPickerPrivate::commitColor(const QColor& color)
+{
+    m_Tracker.finish();
+    if (m_PreviewChannel)
+        m_PreviewChannel->cancel();
+
+    m_ColorPicker->updateColor(color);
+    if (m_Model)
+        m_Model->setColor(color);
+
+    Q_EMIT m_ColorPicker->colorChanged(m_Color);
+}
+
+void ColorPickerPrivate::previewColor(const QColor& color)
 {
+    // child widgets are always kept in sync, only external notifications are subject to the tracking policy
+    m_ColorPicker->updateColor(color);
+    if (m_PreviewChannel)
+        m_PreviewChannel->post(m_Color);
+
+    m_Tracker.changing();
+}
+
+void ColorPickerPrivate::emitColorChanging()
+{
+    if (m_Model)
+        m_Model->setChangingColor(m_Color);
+
+    Q_EMIT m_ColorPicker->colorChanging(m_Color);
+}
+
+void ColorPickerPrivate::showPopup()
+{
+    if (!m_Popup)
+    {
+        m_Popup = new ColorPickerPopup;
+        m_Popup->setMinimumSize(185, 290);
+        m_Popup->setMaximumSize(185, 290);
+        m_Popup->setDisplayAlpha(m_DisplayAlpha);
+        m_Popup->setEditType(m_EditType);
+        m_Popup->setFont(m_ColorPicker->font());
+        m_Popup->setColor(m_Color);
+
+        QObject::connect(m_Popup,
+                         &ColorPickerPopup::colorChanged,
+                         m_ColorPicker,
+                         [this](const QColor& color) { commitColor(color); });
+        QObject::connect(m_Popup,
+                         &ColorPickerPopup::colorChanging,
+                         m_ColorPicker,
+                         [this](const QColor& color) { previewColor(color); });
+    }
+
+    // the popup is not kept in sync while hidden
+    m_Popup->updateColor(m_Color);
+
+    m_Popup->move(m_ColorPicker->mapToGlobal(m_ColorPicker->rect().topLeft()));
+    m_Popup->show();
+}
+
+void ColorPickerPrivate::createChildren()
+{
+    if (m_Hex)
+        return;
+
     QHBoxLayout* layout = new QHBoxLayout;
-    m_Impl->m_Hex       = new ColorHexEdit;
+    m_Hex               = new ColorHexEdit;
     layout->setContentsMargins(0, 0, 0, 0);
 
-    m_Impl->m_Display = new ColorDisplay;
+    m_Display = new ColorDisplay;
 
-    layout->addWidget(m_Impl->m_Display);
-    layout->addWidget(m_Impl->m_Hex);
+    layout->addWidget(m_Display);
+    layout->addWidget(m_Hex);
 
-    setLayout(layout);
+    m_ColorPicker->setLayout(layout);
     layout->setSizeConstraint(QLayout::SetFixedSize);
 
-    QFont font = QFontDatabase::systemFont(QFontDatabase::FixedFont);
-    font.setStyleHint(QFont::TypeWriter);
-    font.setWeight(QFont::ExtraBold);
-    font.setStyleStrategy(QFont::ForceOutline);
-    setFont(font);
+    m_Hex->setDisplayAlpha(m_DisplayAlpha);
+    m_Hex->updateColor(m_Color);
+    m_Display->updateColor(m_Color);
+
+    auto on_color_changed  = [this](const QColor& color) { commitColor(color); };
+    auto on_color_changing = [this](const QColor& color) { previewColor(color); };
+
+    QObject::connect(m_Display, &ColorDisplay::clicked, m_ColorPicker, [this]() { showPopup(); });
+    QObject::connect(m_Display, &ColorDisplay::colorChanged, m_ColorPicker, on_color_changed);
+    QObject::connect(m_Display, &ColorDisplay::colorChanging, m_ColorPicker, on_color_changing);
+
+    QObject::connect(m_Hex, &ColorHexEdit::colorChanged, m_ColorPicker, on_color_changed);
+    QObject::connect(m_Hex, &ColorHexEdit::colorChanging, m_ColorPicker, on_color_changing);
+}
+
+void ColorPickerPrivate::destroyChildren()
+{
+    if (!m_Hex)
+        return;
 
-    auto on_display_clicked = [this]()
+    delete m_ColorPicker->layout();
+    delete m_Hex;
+    delete m_Display;
+    m_Hex     = nullptr;
+    m_Display = nullptr;
+
+    // undo the size constraint imposed by the layout
+    m_ColorPicker->setMinimumSize(0, 0);
+    m_ColorPicker->setMaximumSize(QWIDGETSIZE_MAX, QWIDGETSIZE_MAX);
+}
+
+QRect ColorPickerPrivate::swatchRect() const
+{
+    return SwatchPainter::swatchRect(m_ColorPicker->rect());
+}
+
+QRect ColorPickerPrivate::textRect() const
+{
+    return SwatchPainter::textRect(m_ColorPicker->rect());
+}
+
+QPoint ColorPickerPrivate::textOrigin(const QString& text) const
+{
+    return SwatchPainter::textOrigin(StyleResources::fontMetrics(m_ColorPicker->font()), textRect(), text);
+}
+
+void ColorPickerPrivate::beginEdit(int x)
+{
+    if (!isEditing())
     {
-        if (!m_Impl->m_Popup)
-        {
-            m_Impl->m_Popup = new ColorPickerPopup;
-            m_Impl->m_Popup->setMinimumSize(185, 290);
-            m_Impl->m_Popup->setMaximumSize(185, 290);
-            m_Impl->m_Popup->setDisplayAlpha(m_Impl->m_DisplayAlpha);
-            m_Impl->m_Popup->setEditType(m_Impl->m_EditType);
-            m_Impl->m_Popup->setFont(this->font());
-            m_Impl->m_Popup->setColor(m_Impl->m_Color);
-
-            connect(m_Impl->m_Popup, &ColorPickerPopup::colorChanged, this, &ColorPicker::updateColor);
-            connect(m_Impl->m_Popup, &ColorPickerPopup::colorChanged, this, &ColorPicker::colorChanged);
-            connect(m_Impl->m_Popup, &ColorPickerPopup::colorChanging, this, &ColorPicker::updateColor);
-            connect(m_Impl->m_Popup, &ColorPickerPopup::colorChanging, this, &ColorPicker::colorChanging);
-        }
+        QChar buffer[ColorCodec::MaxLength];
+        m_EditText     = colorToHex(m_Color, m_DisplayAlpha, buffer).mid(1).toString();
+        m_EditColor    = m_Color;
+        m_EditModified = false;
+    }
 
-        m_Impl->m_Popup->move(mapToGlobal(rect().topLeft()));
-        m_Impl->m_Popup->show();
-    };
+    // the text is drawn using a fixed font, so every character has the same width
+    const QFontMetrics fm = StyleResources::fontMetrics(m_ColorPicker->font());
+    const int text_x      = textOrigin("#" + m_EditText).x() + fm.horizontalAdvance(QLatin1Char('#'));
+    const int char_width  = qMax(1, fm.horizontalAdvance(QLatin1Char('0')));
+    m_EditCursorPos       = qBound(0, (x - text_x) / char_width, m_EditText.size() - 1);
+
+    m_ColorPicker->update();
+}
+
+void ColorPickerPrivate::endEdit()
+{
+    if (!isEditing())
+        return;
+
+    const bool modified = m_EditModified;
+    m_EditText          = QString();
+    m_EditModified      = false;
+    m_ColorPicker->update();
+
+    if (modified)
+        commitColor(m_Color);
+}
+
+void ColorPickerPrivate::cancelEdit()
+{
+    if (!isEditing())
+        return;
+
+    const bool modified = m_EditModified;
+    m_EditText          = QString();
+    m_EditModified      = false;
+    m_ColorPicker->update();
+
+    // intermediate colors may have been reported, so the original color has to be committed
+    if (modified)
+        commitColor(m_EditColor);
+}
+
+bool ColorPickerPrivate::isEditing() const
+{
+    return !m_EditText.isNull();
+}
+
+void ColorPickerPrivate::copyColor() const
+{
+    QChar buffer[ColorCodec::MaxLength];
+    QMimeData* mime_data = new QMimeData;
+    mime_data->setColorData(m_Color);
+    mime_data->setText(colorToHex(m_Color, m_DisplayAlpha, buffer).toString());
+    QGuiApplication::clipboard()->setMimeData(mime_data);
+}
+
+bool ColorPickerPrivate::importColor(const QMimeData* mime_data)
+{
+    QColor color;
+    if (!colorFromMimeData(mime_data, &color))
+        return false;
 
-    connect(m_Impl->m_Display, &ColorDisplay::clicked, this, on_display_clicked);
-    connect(m_Impl->m_Display, &ColorDisplay::colorChanged, this, &ColorPicker::updateColor);
-    connect(m_Impl->m_Display, &ColorDisplay::colorChanged, this, &ColorPicker::colorChanged);
-    connect(m_Impl->m_Display, &ColorDisplay::colorChanging, this, &ColorPicker::updateColor);
-    connect(m_Impl->m_Display, &ColorDisplay::colorChanging, this, &ColorPicker::colorChanging);
+    if (!m_DisplayAlpha)
+        color.setAlpha(255);
 
-    connect(m_Impl->m_Hex, &ColorHexEdit::colorChanged, this, &ColorPicker::updateColor);
-    connect(m_Impl->m_Hex, &ColorHexEdit::colorChanged, this, &ColorPicker::colorChanged);
-    connect(m_Impl->m_Hex, &ColorHexEdit::colorChanging, this, &ColorPicker::updateColor);
-    connect(m_Impl->m_Hex, &ColorHexEdit::colorChanging, this, &ColorPicker::colorChanging);
+    // an imported color replaces any edit in progress
+    m_EditText     = QString();
+    m_EditModified = false;
+    m_ColorPicker->update();
 
-    // set default color and sync child widgets
-    setColor(QColor(255, 255, 255, 255));
+    commitColor(color);
+    return true;
+}
+
+//! @endcond
+
+ColorPicker::ColorPicker(QWidget* parent)
+    : QWidget(parent)
+    , m_Impl(new ColorPickerPrivate(this))
+{
+    setFont(StyleResources::pickerFont());
+    setAcceptDrops(true);
+
+    // child widgets are created once the widget is polished, unless lightweight mode has been enabled by then
 }
 
 ColorPicker::~ColorPicker()
@@ -129,9 +374,13 @@ ColorPicker::~ColorPicker()
 
 void ColorPicker::updateColor(const QColor& color)
 {
-    m_Impl->m_Hex->updateColor(color);
-    m_Impl->m_Display->updateColor(color);
-    if (m_Impl->m_Popup)
+    if (m_Impl->m_Hex)
+    {
+        m_Impl->m_Hex->updateColor(color);
+        m_Impl->m_Display->updateColor(color);
+    }
+
+    if (m_Impl->m_Popup && m_Impl->m_Popup->isVisible())
         m_Impl->m_Popup->updateColor(color);
 
     if (m_Impl->m_Color != color)
@@ -143,13 +392,70 @@ void ColorPicker::updateColor(const QColor& color)
 
 void ColorPicker::setColor(const QColor& color)
 {
+    // a hidden widget may not have caught up with the model yet
+    m_Impl->syncFromModel();
     if (m_Impl->m_Color != color)
     {
-        updateColor(color);
-        Q_EMIT colorChanged(m_Impl->m_Color);
+        m_Impl->commitColor(color);
     }
 }
 
+QColor ColorPicker::color() const
+{
+    m_Impl->syncFromModel();
+    return m_Impl->m_Color;
+}
+
+void ColorPicker::setModel(ColorModel* model)
+{
+    if (m_Impl->m_Model == model)
+        return;
+
+    if (m_Impl->m_Model)
+        disconnect(m_Impl->m_Model, nullptr, this, nullptr);
+
+    m_Impl->m_Model = model;
+    if (!model)
+        return;
+
+    // hidden widgets only catch up with the model once they are shown again
+    auto on_model_changed = [this]()
+    {
+        if (isVisible())
+            m_Impl->syncFromModel();
+    };
+
+    connect(model, &ColorModel::colorChanged, this, on_model_changed);
+    connect(model, &ColorModel::colorChanging, this, on_model_changed);
+
+    m_Impl->m_ModelVersion = model->version();
+    updateColor(model->color());
+}
+
+ColorModel* ColorPicker::model() const
+{
+    return m_Impl->m_Model;
+}
+
+void ColorPicker::setPreviewChannel(ColorPreviewChannel* channel)
+{
+    if (m_Impl->m_PreviewChannel)
+        m_Impl->m_PreviewChannel->cancel();
+
+    m_Impl->m_PreviewChannel = channel;
+}
+
+ColorPreviewChannel* ColorPicker::previewChannel() const
+{
+    return m_Impl->m_PreviewChannel;
+}
+
+void ColorPicker::showEvent(QShowEvent* event)
+{
+    m_Impl->syncFromModel();
+    QWidget::showEvent(event);
+}
+
 void ColorPicker::setDisplayAlpha(bool visible)
 {
     m_Impl->m_DisplayAlpha = visible;
@@ -158,7 +464,12 @@ void ColorPicker::setDisplayAlpha(bool visible)
         m_Impl->m_Popup->setDisplayAlpha(visible);
     }
 
-    m_Impl->m_Hex->setDisplayAlpha(visible);
+    if (m_Impl->m_Hex)
+        m_Impl->m_Hex->setDisplayAlpha(visible);
+
+    m_Impl->cancelEdit();
+    updateGeometry();
+    update();
 }
 
 bool ColorPicker::displayAlpha()
@@ -179,3 +490,279 @@ ColorPicker::EditType ColorPicker::editType()
 {
     return m_Impl->m_EditType;
 }
+
+void ColorPicker::setTrackingPolicy(TrackingPolicy policy)
+{
+    m_Impl->m_Tracker.setPolicy(static_cast<ChangeTracker::Policy>(policy));
+}
+
+ColorPicker::TrackingPolicy ColorPicker::trackingPolicy() const
+{
+    return static_cast<TrackingPolicy>(m_Impl->m_Tracker.policy());
+}
+
+void ColorPicker::setTrackingInterval(int msec)
+{
+    m_Impl->m_Tracker.setInterval(msec);
+}
+
+int ColorPicker::trackingInterval() const
+{
+    return m_Impl->m_Tracker.interval();
+}
+
+void ColorPicker::setLightweight(bool lightweight)
+{
+    if (m_Impl->m_Lightweight == lightweight)
+        return;
+
+    m_Impl->cancelEdit();
+    m_Impl->m_Lightweight = lightweight;
+
+    if (lightweight)
+    {
+        m_Impl->destroyChildren();
+        setFocusPolicy(Qt::StrongFocus);
+        setSizePolicy(QSizePolicy::Fixed, QSizePolicy::Fixed);
+    }
+    else
+    {
+        setFocusPolicy(Qt::NoFocus);
+        setSizePolicy(QSizePolicy::Preferred, QSizePolicy::Preferred);
+        if (testAttribute(Qt::WA_WState_Polished))
+            m_Impl->createChildren();
+    }
+
+    updateGeometry();
+    update();
+}
+
+bool ColorPicker::lightweight() const
+{
+    return m_Impl->m_Lightweight;
+}
+
+ColorSwatchStyleOption::ColorSwatchStyleOption()
+    : font(StyleResources::pickerFont())
+    , color(Qt::white)
+    , displayAlpha(true)
+    , displayText(true)
+{}
+
+ColorWheelStyleOption::ColorWheelStyleOption()
+    : color(Qt::white)
+{}
+
+void ColorPicker::paintSwatch(QPainter* painter, const ColorSwatchStyleOption& option)
+{
+    QColor color = option.color;
+    if (!option.displayAlpha)
+        color.setAlpha(255);
+
+    painter->save();
+    if (option.displayText)
+    {
+        painter->setFont(option.font);
+        SwatchPainter::draw(*painter, option.palette, option.rect, color, option.displayAlpha);
+    }
+    else
+    {
+        SwatchPainter::drawSwatch(*painter, option.rect, color);
+    }
+    painter->restore();
+}
+
+void ColorPicker::paintWheel(QPainter* painter, const ColorWheelStyleOption& option)
+{
+    const QRect square = HueSaturationWheel::fittedSquare(option.rect);
+
+    painter->save();
+    painter->setRenderHint(QPainter::Antialiasing);
+    HueSaturationWheel::drawWheel(*painter, square, option.color.valueF());
+    HueSaturationWheel::drawMarker(*painter, HueSaturationWheel::markerPos(square, option.color), option.color);
+    painter->restore();
+}
+
+QSize ColorPicker::sizeHint() const
+{
+    if (!m_Impl->m_Lightweight)
+        return QWidget::sizeHint();
+
+    return SwatchPainter::sizeHint(StyleResources::fontMetrics(font()), m_Impl->m_DisplayAlpha);
+}
+
+bool ColorPicker::event(QEvent* event)
+{
+    if (event->type() == QEvent::Polish && !m_Impl->m_Lightweight)
+        m_Impl->createChildren();
+
+    return QWidget::event(event);
+}
+
+void ColorPicker::paintEvent(QPaintEvent* event)
+{
+    if (!m_Impl->m_Lightweight)
+    {
+        QWidget::paintEvent(event);
+        return;
+    }
+
+    const QRect swatch_rect = m_Impl->swatchRect();
+    const QRect text_rect   = m_Impl->textRect();
+
+    QPainter painter(this);
+    painter.save();
+
+    SwatchPainter::drawSwatch(painter, swatch_rect, m_Impl->m_Color);
+    SwatchPainter::drawTextFrame(painter, palette(), text_rect);
+
+    QChar buffer[ColorCodec::MaxLength];
+    const QString text = m_Impl->isEditing() ? QStringLiteral("#") + m_Impl->m_EditText
+                                             : colorToHex(m_Impl->m_Color, m_Impl->m_DisplayAlpha, buffer).toString();
+    const QPoint origin = m_Impl->textOrigin(text);
+
+    painter.setPen(palette().text().color());
+    painter.drawText(origin, text);
+
+    if (m_Impl->isEditing())
+    {
+        // the cursor is on the character after the '#'
+        const QFontMetrics fm = StyleResources::fontMetrics(font());
+        SwatchPainter::drawEditCursor(painter, palette(), fm, text_rect, origin, text, m_Impl->m_EditCursorPos + 1);
+    }
+
+    if (hasFocus())
+    {
+        painter.setClipRect(rect(), Qt::NoClip);
+        QStyleOptionFocusRect opts;
+        opts.initFrom(this);
+        opts.rect            = text_rect;
+        opts.backgroundColor = palette().base().color();
+        style()->drawPrimitive(QStyle::PE_FrameFocusRect, &opts, &painter, this);
+    }
+
+    painter.restore();
+}
+
+void ColorPicker::mouseReleaseEvent(QMouseEvent* event)
+{
+    if (!m_Impl->m_Lightweight)
+    {
+        QWidget::mouseReleaseEvent(event);
+        return;
+    }
+
+    if (m_Impl->swatchRect().contains(event->pos()))
+    {
+        m_Impl->endEdit();
+        m_Impl->showPopup();
+    }
+    else
+    {
+        m_Impl->beginEdit(event->pos().x());
+    }
+}
+
+void ColorPicker::keyPressEvent(QKeyEvent* event)
+{
+    if (!m_Impl->m_Lightweight)
+    {
+        QWidget::keyPressEvent(event);
+        return;
+    }
+
+    if (event->matches(QKeySequence::Copy))
+    {
+        m_Impl->copyColor();
+        return;
+    }
+
+    if (event->matches(QKeySequence::Paste))
+    {
+        if (!m_Impl->importColor(QGuiApplication::clipboard()->mimeData()))
+            QWidget::keyPressEvent(event);
+        return;
+    }
+
+    const int key         = event->key();
+    const bool is_hex_key = isHexDigit(event);
+
+    if (!m_Impl->isEditing())
+    {
+        // directly enter edit mode if a hex digit is typed
+        if (key == Qt::Key_Return || key == Qt::Key_Enter || key == Qt::Key_F2 || is_hex_key)
+            m_Impl->beginEdit(0);
+
+        if (!is_hex_key)
+        {
+            if (!m_Impl->isEditing())
+                QWidget::keyPressEvent(event);
+            return;
+        }
+    }
+
+    const int last = m_Impl->m_EditText.size() - 1;
+    switch (key)
+    {
+        case Qt::Key_Escape:
+            m_Impl->cancelEdit();
+            break;
+        case Qt::Key_Return:
+        case Qt::Key_Enter:
+            m_Impl->endEdit();
+            break;
+        case Qt::Key_Left:
+        case Qt::Key_Backspace:
+            m_Impl->m_EditCursorPos = qMax(0, m_Impl->m_EditCursorPos - 1);
+            break;
+        case Qt::Key_Right:
+            m_Impl->m_EditCursorPos = qMin(last, m_Impl->m_EditCursorPos + 1);
+            break;
+        case Qt::Key_Home:
+            m_Impl->m_EditCursorPos = 0;
+            break;
+        case Qt::Key_End:
+            m_Impl->m_EditCursorPos = last;
+            break;
+        default:
+            if (!is_hex_key)
+            {
+                QWidget::keyPressEvent(event);
+                return;
+            }
+
+            // overwrite the character under the cursor. Qt::Key_0-9 and Qt::Key_A-F match their ASCII codes
+            m_Impl->m_EditText[m_Impl->m_EditCursorPos] = QLatin1Char(static_cast<char>(key));
+            m_Impl->m_EditCursorPos                     = qMin(last, m_Impl->m_EditCursorPos + 1);
+            m_Impl->m_EditModified                      = true;
+            QColor color;
+            if (ColorCodec::parse(m_Impl->m_EditText, &color))
+                m_Impl->previewColor(color);
+            break;
+    }
+
+    update();
+}
+
+void ColorPicker::dragEnterEvent(QDragEnterEvent* event)
+{
+    QColor color;
+    if (colorFromMimeData(event->mimeData(), &color))
+        event->acceptProposedAction();
+    else
+        QWidget::dragEnterEvent(event);
+}
+
+void ColorPicker::dropEvent(QDropEvent* event)
+{
+    if (m_Impl->importColor(event->mimeData()))
+        event->acceptProposedAction();
+    else
+        QWidget::dropEvent(event);
+}
+
+void ColorPicker::focusOutEvent(QFocusEvent* event)
+{
+    m_Impl->endEdit();
+    QWidget::focusOutEvent(event);
+}
@@ -0,0 +1,188 @@
+/*
+ * Copyright (c) 2021 Victor Wåhlström
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ * claim that you wrote the original software. If you use this software
+ * in a product, an acknowledgment in the product documentation would be
+ * appreciated but is not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source
+ */
+
+
+#include "editorpool_p.h"
+#include "styleresources_p.h"
+#include "swatchpainter_p.h"
+
+#include <ZtWidgets/colorpickerdelegate.h>
+
+#include <QApplication>
+#include <QStyle>
+
+//! @cond Doxygen_Suppress
+class ColorPickerDelegatePrivate
+{
+    Q_DISABLE_COPY(ColorPickerDelegatePrivate)
+
+  public:
+    ColorPickerDelegatePrivate();
+
+    EditorPool<ColorPicker> m_Pool;
+    ColorPicker::EditType m_EditType;
+    bool m_DisplayAlpha;
+};
+
+ColorPickerDelegatePrivate::ColorPickerDelegatePrivate()
+    : m_EditType(ColorPicker::Float)
+    , m_DisplayAlpha(true)
+{}
+//! @endcond
+
+ColorPickerDelegate::ColorPickerDelegate(QObject* parent)
+    : QStyledItemDelegate(parent)
+    , m_Impl(new ColorPickerDelegatePrivate())
+{}
+
+ColorPickerDelegate::~ColorPickerDelegate()
+{
+    delete m_Impl;
+}
+
+void ColorPickerDelegate::setDisplayAlpha(bool visible)
+{
+    m_Impl->m_DisplayAlpha = visible;
+}
+
+bool ColorPickerDelegate::displayAlpha() const
+{
+    return m_Impl->m_DisplayAlpha;
+}
+
+void ColorPickerDelegate::setEditType(ColorPicker::EditType type)
+{
+    m_Impl->m_EditType = type;
+}
+
+ColorPicker::EditType ColorPickerDelegate::editType() const
+{
+    return m_Impl->m_EditType;
+}
+
+void ColorPickerDelegate::paint(QPainter* painter, const QStyleOptionViewItem& option, const QModelIndex& index) const
+{
+    const QColor color = qvariant_cast<QColor>(index.data(Qt::EditRole));
+    if (!color.isValid())
+    {
+        QStyledItemDelegate::paint(painter, option, index);
+        return;
+    }
+
+    QStyleOptionViewItem opt = option;
+    initStyleOption(&opt, index);
+
+    // the background, selection and focus of the item, without the text of the display role
+    opt.text.clear();
+    opt.features &= ~QStyleOptionViewItem::HasDisplay;
+    const QWidget* widget = opt.widget;
+    QStyle* style         = widget ? widget->style() : QApplication::style();
+    style->drawControl(QStyle::CE_ItemViewItem, &opt, painter, widget);
+
+    ColorSwatchStyleOption swatch;
+    swatch.rect         = opt.rect;
+    swatch.palette      = opt.palette;
+    swatch.color        = color;
+    swatch.displayAlpha = m_Impl->m_DisplayAlpha;
+    ColorPicker::paintSwatch(painter, swatch);
+}
+
+QSize ColorPickerDelegate::sizeHint(const QStyleOptionViewItem& option, const QModelIndex& index) const
+{
+    if (!qvariant_cast<QColor>(index.data(Qt::EditRole)).isValid())
+        return QStyledItemDelegate::sizeHint(option, index);
+
+    // the same as the size hint of a lightweight ColorPicker
+    return SwatchPainter::sizeHint(StyleResources::fontMetrics(StyleResources::pickerFont()), m_Impl->m_DisplayAlpha);
+}
+
+void ColorPickerDelegate::setEditorPoolSize(int size)
+{
+    m_Impl->m_Pool.setCapacity(size);
+}
+
+int ColorPickerDelegate::editorPoolSize() const
+{
+    return m_Impl->m_Pool.capacity();
+}
+
+QWidget* ColorPickerDelegate::createEditor(QWidget* parent, const QStyleOptionViewItem&, const QModelIndex&) const
+{
+    ColorPicker* editor = m_Impl->m_Pool.take(parent);
+    if (!editor)
+    {
+        editor = new ColorPicker(parent);
+        editor->setLightweight(true);
+        editor->setAutoFillBackground(true);
+
+        // commitData is a signal, and createEditor() is const only by the signature of QAbstractItemDelegate
+        ColorPickerDelegate* self = const_cast<ColorPickerDelegate*>(this);
+        connect(editor, &ColorPicker::colorChanged, self, [self, editor]() { Q_EMIT self->commitData(editor); });
+    }
+
+    // the settings of the delegate may have changed since a pooled editor was last used
+    if (editor->displayAlpha() != m_Impl->m_DisplayAlpha)
+        editor->setDisplayAlpha(m_Impl->m_DisplayAlpha);
+    if (editor->editType() != m_Impl->m_EditType)
+        editor->setEditType(m_Impl->m_EditType);
+
+    return editor;
+}
+
+void ColorPickerDelegate::destroyEditor(QWidget* editor, const QModelIndex& index) const
+{
+    // the view has already hidden the editor and committed its color
+    ColorPicker* color_picker = qobject_cast<ColorPicker*>(editor);
+    if (!color_picker || !m_Impl->m_Pool.give(color_picker))
+        QStyledItemDelegate::destroyEditor(editor, index);
+}
+
+void ColorPickerDelegate::setEditorData(QWidget* editor, const QModelIndex& index) const
+{
+    ColorPicker* color_picker = qobject_cast<ColorPicker*>(editor);
+    if (!color_picker)
+    {
+        QStyledItemDelegate::setEditorData(editor, index);
+        return;
+    }
+
+    color_picker->updateColor(qvariant_cast<QColor>(index.data(Qt::EditRole)));
+}
+
+void ColorPickerDelegate::setModelData(QWidget* editor, QAbstractItemModel* model, const QModelIndex& index) const
+{
+    ColorPicker* color_picker = qobject_cast<ColorPicker*>(editor);
+    if (!color_picker)
+    {
+        QStyledItemDelegate::setModelData(editor, model, index);
+        return;
+    }
+
+    model->setData(index, color_picker->color(), Qt::EditRole);
+}
+
+void ColorPickerDelegate::updateEditorGeometry(QWidget* editor,
+                                               const QStyleOptionViewItem& option,
+                                               const QModelIndex&) const
+{
+    editor->setGeometry(option.rect);
+}
@@ -25,8 +25,7 @@
 #include "colordisplay_p.h"
 #include "colorhexedit_p.h"
 #include "huesaturationwheel_p.h"
-
-#include "color_utils_p.h"
+#include "styleresources_p.h"
 
 #include <ZtWidgets/colorpicker.h>
 #include <ZtWidgets/slideredit.h>
@@ -36,12 +35,11 @@
 #include <QDesktopWidget>
 #include <QFrame>
 #include <QLabel>
-#include <QPainter>
+#include <QPair>
 #include <QPushButton>
 #include <QResizeEvent>
 #include <QStackedWidget>
 #include <QVBoxLayout>
-#include <QtMath>
 
 enum class ColorChannel
 {
@@ -57,11 +55,6 @@ enum class ColorChannel
     Value,
 };
 
-static bool isBright(const QColor& c)
-{
-    return qSqrt(qPow(c.redF(), 2) * 0.299f + qPow(c.greenF(), 2) * 0.587f + qPow(c.blueF(), 2) * 0.114f) > 0.6f;
-}
-
 static void valueToColor(QColor& color, ColorPicker::EditType t, ColorChannel channel, qreal val)
 {
     switch (channel)
@@ -110,52 +103,39 @@ static void valueToColor(QColor& color, ColorPicker::EditType t, ColorChannel ch
 class ColorSliderEdit : public SliderEdit
 {
   public:
-    explicit ColorSliderEdit(const QMap<qreal, QColor>& gradients)
+    explicit ColorSliderEdit(StyleResources::Gradient gradient)
         : SliderEdit()
-        , m_Gradients(gradients)
-        , m_TextColor(isBright(gradients.last()) ? Qt::black : Qt::white)
+        , m_Gradient(gradient)
+        , m_Integral(false)
     {
         setSliderComponents(SliderEdit::SliderComponent::Marker | SliderEdit::SliderComponent::Text);
         setAlignment(Qt::AlignRight);
     }
 
+    // the edit type is chosen at runtime, so this can't be an IntSliderEdit
+    void setIntegral(bool integral) { m_Integral = integral; }
+
   protected:
-    void resizeEvent(QResizeEvent* event)
+    qreal normalizeValue(qreal value) const override
     {
-        QPalette p = palette();
-
-        QImage img(event->size(), QImage::Format_ARGB32_Premultiplied);
-        img.fill(0);
-
-        QRect r = img.rect();
-        QPainter painter(&img);
-
-        quint32 size = qMin(r.width(), r.height()) / 2;
-        drawCheckerboard(painter, r, size);
-
-        QLinearGradient g;
-        if (orientation() == Qt::Horizontal)
-            g = QLinearGradient(QPointF(0.0f, 0.0f), QPointF((float)event->size().width(), 0.0f));
-        else
-            g = QLinearGradient(QPointF(0.0f, (float)event->size().height()), QPointF(0.0f, 0.0f));
-
-        auto i = m_Gradients.begin();
-        while (i != m_Gradients.end())
-        {
-            g.setColorAt(i.key(), i.value());
-            ++i;
-        }
+        // integer channels never hold fractions, so reported values need no further rounding
+        return m_Integral ? qRound(value) : SliderEdit::normalizeValue(value);
+    }
 
-        painter.fillRect(r, g);
+    quint32 valueDecimals() const override { return m_Integral ? 0 : SliderEdit::valueDecimals(); }
 
-        p.setBrush(QPalette::Base, img);
-        p.setBrush(QPalette::Text, m_TextColor);
+    void resizeEvent(QResizeEvent* event) override
+    {
+        // sliders of the same size and gradient share the same image
+        QPalette p = palette();
+        p.setBrush(QPalette::Base, StyleResources::gradientImage(m_Gradient, event->size(), orientation()));
+        p.setBrush(QPalette::Text, StyleResources::contrastTextColor(m_Gradient));
         setPalette(p);
     }
 
   private:
-    const QMap<qreal, QColor> m_Gradients;
-    const QColor m_TextColor;
+    const StyleResources::Gradient m_Gradient;
+    bool m_Integral;
 };
 
 class ColorPickerPopupPrivate
@@ -251,68 +231,38 @@ ColorPickerPopup::ColorPickerPopup(QWidget* parent)
     size_policy.setHorizontalPolicy(QSizePolicy::Expanding);
     m_Impl->m_Wheel->setSizePolicy(size_policy);
 
-    QMap<qreal, QColor> bw_gradient;
-    bw_gradient[0] = Qt::black;
-    bw_gradient[1] = Qt::white;
-    QMap<qreal, QColor> red_gradient;
-    red_gradient[0] = Qt::black;
-    red_gradient[1] = Qt::red;
-    QMap<qreal, QColor> green_gradient;
-    green_gradient[0] = Qt::black;
-    green_gradient[1] = Qt::green;
-    QMap<qreal, QColor> blue_gradient;
-    blue_gradient[0] = Qt::black;
-    blue_gradient[1] = Qt::blue;
-    QMap<qreal, QColor> alpha_gradient;
-    alpha_gradient[0] = QColor(255, 255, 255, 0);
-    alpha_gradient[1] = Qt::white;
-
-    QMap<qreal, QColor> hue_gradient;
-    QColor hue_color;
-
-    qreal step = 0.0;
-    while (step < 1.0)
-    {
-        hue_color.setHsvF(step, 1.0, 1.0);
-        hue_gradient[step] = hue_color;
-        step += 0.1;
-    }
-
-    blue_gradient[0] = Qt::black;
-    blue_gradient[1] = Qt::blue;
-
-    m_Impl->m_ValueSlider = new ColorSliderEdit(bw_gradient);
+    m_Impl->m_ValueSlider = new ColorSliderEdit(StyleResources::BlackWhite);
     m_Impl->m_ValueSlider->setToolTip(tr("Value"));
     m_Impl->m_ValueSlider->setOrientation(Qt::Vertical);
 
     QPalette p = palette();
     p.setBrush(QPalette::Text, Qt::white);
 
-    m_Impl->m_RedSlider = new ColorSliderEdit(red_gradient);
+    m_Impl->m_RedSlider = new ColorSliderEdit(StyleResources::Red);
     m_Impl->m_RedSlider->setToolTip(tr("Red"));
-    m_Impl->m_GreenSlider = new ColorSliderEdit(green_gradient);
+    m_Impl->m_GreenSlider = new ColorSliderEdit(StyleResources::Green);
     m_Impl->m_GreenSlider->setToolTip(tr("Green"));
-    m_Impl->m_BlueSlider = new ColorSliderEdit(blue_gradient);
+    m_Impl->m_BlueSlider = new ColorSliderEdit(StyleResources::Blue);
     m_Impl->m_BlueSlider->setToolTip(tr("Blue"));
-    m_Impl->m_RgbAlphaSlider = new ColorSliderEdit(alpha_gradient);
+    m_Impl->m_RgbAlphaSlider = new ColorSliderEdit(StyleResources::Alpha);
     m_Impl->m_RgbAlphaSlider->setToolTip(tr("Alpha"));
 
-    m_Impl->m_HslHueSlider = new ColorSliderEdit(hue_gradient);
+    m_Impl->m_HslHueSlider = new ColorSliderEdit(StyleResources::Hue);
     m_Impl->m_HslHueSlider->setToolTip(tr("Hue"));
-    m_Impl->m_HslSaturationSlider = new ColorSliderEdit(bw_gradient);
+    m_Impl->m_HslSaturationSlider = new ColorSliderEdit(StyleResources::BlackWhite);
     m_Impl->m_HslSaturationSlider->setToolTip(tr("Saturation"));
-    m_Impl->m_LightnessSlider = new ColorSliderEdit(bw_gradient);
+    m_Impl->m_LightnessSlider = new ColorSliderEdit(StyleResources::BlackWhite);
     m_Impl->m_LightnessSlider->setToolTip(tr("Lightness"));
-    m_Impl->m_HslAlphaSlider = new ColorSliderEdit(alpha_gradient);
+    m_Impl->m_HslAlphaSlider = new ColorSliderEdit(StyleResources::Alpha);
     m_Impl->m_HslAlphaSlider->setToolTip(tr("Alpha"));
 
-    m_Impl->m_HsvHueSlider = new ColorSliderEdit(hue_gradient);
+    m_Impl->m_HsvHueSlider = new ColorSliderEdit(StyleResources::Hue);
     m_Impl->m_HsvHueSlider->setToolTip(tr("Hue"));
-    m_Impl->m_HsvSaturationSlider = new ColorSliderEdit(bw_gradient);
+    m_Impl->m_HsvSaturationSlider = new ColorSliderEdit(StyleResources::BlackWhite);
     m_Impl->m_HsvSaturationSlider->setToolTip(tr("Saturation"));
-    m_Impl->m_HsvValueSlider = new ColorSliderEdit(bw_gradient);
+    m_Impl->m_HsvValueSlider = new ColorSliderEdit(StyleResources::BlackWhite);
     m_Impl->m_HsvValueSlider->setToolTip(tr("Value"));
-    m_Impl->m_HsvAlphaSlider = new ColorSliderEdit(alpha_gradient);
+    m_Impl->m_HsvAlphaSlider = new ColorSliderEdit(StyleResources::Alpha);
     m_Impl->m_HsvAlphaSlider->setToolTip(tr("Alpha"));
 
     QHBoxLayout* mid_layout = new QHBoxLayout;
@@ -704,15 +654,17 @@ void ColorPickerPopup::setEditType(ColorPicker::EditType type)
 {
     m_Impl->m_EditType = type;
 
-    auto update_slider = [&](SliderEdit* w, ColorChannel c)
+    auto update_slider = [&](ColorSliderEdit* w, ColorChannel c)
     {
         switch (type)
         {
             case ColorPicker::EditType::Int:
+                w->setIntegral(true);
                 w->setRange(0, c == ColorChannel::HslHue || c == ColorChannel::HsvHue ? 359 : 255);
                 w->setPrecision(0);
                 break;
             case ColorPicker::EditType::Float:
+                w->setIntegral(false);
                 w->setRange(0.0f, 1.0f);
                 w->setPrecision(3);
                 break;
@@ -722,20 +674,39 @@ void ColorPickerPopup::setEditType(ColorPicker::EditType type)
         }
     };
 
-    update_slider(m_Impl->m_ValueSlider, ColorChannel::Value);
+    const QPair<ColorSliderEdit*, ColorChannel> sliders[] = {
+        {m_Impl->m_ValueSlider, ColorChannel::Value},
+
+        {m_Impl->m_RedSlider, ColorChannel::Red},
+        {m_Impl->m_GreenSlider, ColorChannel::Green},
+        {m_Impl->m_BlueSlider, ColorChannel::Blue},
+        {m_Impl->m_RgbAlphaSlider, ColorChannel::Alpha},
 
-    update_slider(m_Impl->m_RedSlider, ColorChannel::Red);
-    update_slider(m_Impl->m_GreenSlider, ColorChannel::Green);
-    update_slider(m_Impl->m_BlueSlider, ColorChannel::Blue);
-    update_slider(m_Impl->m_RgbAlphaSlider, ColorChannel::Alpha);
+        {m_Impl->m_HslHueSlider, ColorChannel::HslHue},
+        {m_Impl->m_HslSaturationSlider, ColorChannel::HslSaturation},
+        {m_Impl->m_LightnessSlider, ColorChannel::Lightness},
+        {m_Impl->m_HslAlphaSlider, ColorChannel::Alpha},
 
-    update_slider(m_Impl->m_HslHueSlider, ColorChannel::HslHue);
-    update_slider(m_Impl->m_HslSaturationSlider, ColorChannel::HslSaturation);
-    update_slider(m_Impl->m_LightnessSlider, ColorChannel::Lightness);
-    update_slider(m_Impl->m_HslAlphaSlider, ColorChannel::Alpha);
+        {m_Impl->m_HsvHueSlider, ColorChannel::HsvHue},
+        {m_Impl->m_HsvSaturationSlider, ColorChannel::HsvSaturation},
+        {m_Impl->m_HsvValueSlider, ColorChannel::Value},
+        {m_Impl->m_HsvAlphaSlider, ColorChannel::Alpha},
+    };
+
+    // the values in the old units are meaningless in the new ones, so the sliders must not report them. Each slider is
+    // repainted once, after its values have been converted from the color.
+    for (const auto& slider : sliders)
+    {
+        slider.first->blockSignals(true);
+        slider.first->beginBatch();
+        update_slider(slider.first, slider.second);
+    }
 
-    update_slider(m_Impl->m_HsvHueSlider, ColorChannel::HsvHue);
-    update_slider(m_Impl->m_HsvSaturationSlider, ColorChannel::HsvSaturation);
-    update_slider(m_Impl->m_HsvValueSlider, ColorChannel::Value);
-    update_slider(m_Impl->m_HsvAlphaSlider, ColorChannel::Alpha);
+    updateColor(m_Impl->m_Color);
+
+    for (const auto& slider : sliders)
+    {
+        slider.first->endBatch();
+        slider.first->blockSignals(false);
+    }
 }
@@ -0,0 +1,133 @@
+/*
+ * Copyright (c) 2021 Victor Wåhlström
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ * claim that you wrote the original software. If you use this software
+ * in a product, an acknowledgment in the product documentation would be
+ * appreciated but is not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source
+ */
+
+
+#include <ZtWidgets/colorpreviewchannel.h>
+
+#include <QMutex>
+#include <QMutexLocker>
+#include <QThreadPool>
+#include <QWaitCondition>
+
+ColorPreviewToken::ColorPreviewToken()
+    : m_Ticket(0)
+{}
+
+ColorPreviewToken::ColorPreviewToken(const QSharedPointer<QAtomicInt>& generation, int ticket)
+    : m_Generation(generation)
+    , m_Ticket(ticket)
+{}
+
+bool ColorPreviewToken::isCancelled() const
+{
+    return m_Generation && m_Generation->loadAcquire() != m_Ticket;
+}
+
+//! @cond Doxygen_Suppress
+class ColorPreviewChannelPrivate
+{
+    Q_DISABLE_COPY(ColorPreviewChannelPrivate)
+
+  public:
+    explicit ColorPreviewChannelPrivate(ColorPreviewChannel::Handler handler);
+
+    void run();
+
+    ColorPreviewChannel::Handler m_Handler;
+    QSharedPointer<QAtomicInt> m_Generation;
+    QMutex m_Mutex;
+    QWaitCondition m_Idle;
+    QColor m_Pending;
+    int m_PendingTicket;
+    bool m_HasPending : 1;
+    bool m_Running : 1;
+};
+
+ColorPreviewChannelPrivate::ColorPreviewChannelPrivate(ColorPreviewChannel::Handler handler)
+    : m_Handler(handler)
+    , m_Generation(new QAtomicInt(0))
+    , m_PendingTicket(0)
+    , m_HasPending(false)
+    , m_Running(false)
+{}
+
+void ColorPreviewChannelPrivate::run()
+{
+    QMutexLocker lock(&m_Mutex);
+    while (m_HasPending)
+    {
+        const QColor color = m_Pending;
+        const ColorPreviewToken token(m_Generation, m_PendingTicket);
+        m_HasPending = false;
+
+        lock.unlock();
+        if (!token.isCancelled())
+            m_Handler(color, token);
+        lock.relock();
+    }
+
+    m_Running = false;
+    m_Idle.wakeAll();
+}
+//! @endcond
+
+ColorPreviewChannel::ColorPreviewChannel(Handler handler, QObject* parent)
+    : QObject(parent)
+    , m_Impl(new ColorPreviewChannelPrivate(handler))
+{}
+
+ColorPreviewChannel::~ColorPreviewChannel()
+{
+    cancel();
+
+    {
+        QMutexLocker lock(&m_Impl->m_Mutex);
+        while (m_Impl->m_Running)
+            m_Impl->m_Idle.wait(&m_Impl->m_Mutex);
+    }
+}
+
+void ColorPreviewChannel::post(const QColor& color)
+{
+    QMutexLocker lock(&m_Impl->m_Mutex);
+
+    // superseding the previous request also cancels its token
+    m_Impl->m_Pending       = color;
+    m_Impl->m_PendingTicket = m_Impl->m_Generation->fetchAndAddOrdered(1) + 1;
+    m_Impl->m_HasPending    = true;
+
+    if (!m_Impl->m_Running)
+    {
+        m_Impl->m_Running = true;
+
+        // the worker keeps the private data alive until it has released the mutex
+        QSharedPointer<ColorPreviewChannelPrivate> impl = m_Impl;
+        QThreadPool::globalInstance()->start([impl]() { impl->run(); });
+    }
+}
+
+void ColorPreviewChannel::cancel()
+{
+    QMutexLocker lock(&m_Impl->m_Mutex);
+    m_Impl->m_HasPending = false;
+    m_Impl->m_Generation->fetchAndAddOrdered(1);
+}
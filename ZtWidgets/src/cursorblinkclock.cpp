@@ -0,0 +1,147 @@
+/*
+ * Copyright (c) 2021 Victor Wåhlström
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ * claim that you wrote the original software. If you use this software
+ * in a product, an acknowledgment in the product documentation would be
+ * appreciated but is not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source
+ */
+
+
+#include "cursorblinkclock_p.h"
+
+#include <QBasicTimer>
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QPointer>
+#include <QTimerEvent>
+#include <QWidget>
+
+static constexpr const int S_BLINK_INTERVAL = 500;
+// stop waking up once the user has evidently walked away from the edit
+static constexpr const int S_IDLE_TIMEOUT = 15000;
+
+//! @cond Doxygen_Suppress
+class CursorBlinkClockTimer : public QObject
+{
+    Q_DISABLE_COPY(CursorBlinkClockTimer)
+
+  public:
+    explicit CursorBlinkClockTimer(QObject* parent);
+
+    static CursorBlinkClockTimer* instance();
+
+    void setVisible(bool visible);
+
+    QPointer<QWidget> m_Widget;
+    QBasicTimer m_Timer;
+    QElapsedTimer m_LastActivity;
+    bool m_Visible;
+
+  protected:
+    void timerEvent(QTimerEvent* event) override;
+};
+
+CursorBlinkClockTimer::CursorBlinkClockTimer(QObject* parent)
+    : QObject(parent)
+    , m_Visible(true)
+{}
+
+CursorBlinkClockTimer* CursorBlinkClockTimer::instance()
+{
+    // owned by the application object, like the other process-wide resources
+    static QPointer<CursorBlinkClockTimer> s_Clock;
+    if (!s_Clock)
+        s_Clock = new CursorBlinkClockTimer(QCoreApplication::instance());
+
+    return s_Clock;
+}
+
+void CursorBlinkClockTimer::setVisible(bool visible)
+{
+    if (m_Visible == visible)
+        return;
+
+    m_Visible = visible;
+    if (m_Widget)
+        m_Widget->update();
+}
+
+void CursorBlinkClockTimer::timerEvent(QTimerEvent* event)
+{
+    if (event->timerId() != m_Timer.timerId())
+    {
+        QObject::timerEvent(event);
+        return;
+    }
+
+    // the next activity restarts the clock; until then the cursor is left solid
+    if (!m_Widget || !m_Widget->isActiveWindow() || m_LastActivity.hasExpired(S_IDLE_TIMEOUT))
+    {
+        m_Timer.stop();
+        setVisible(true);
+        return;
+    }
+
+    // the first tick may have been delayed for longer than the blink interval
+    m_Timer.start(S_BLINK_INTERVAL, this);
+    setVisible(!m_Visible);
+}
+//! @endcond
+
+void CursorBlinkClock::activity(QWidget* widget, int delay)
+{
+    CursorBlinkClockTimer* clock = CursorBlinkClockTimer::instance();
+    if (clock->m_Widget != widget)
+    {
+        // the previous subscriber may be left in the hidden phase
+        if (clock->m_Widget)
+            clock->m_Widget->update();
+        clock->m_Widget  = widget;
+        clock->m_Visible = true;
+    }
+
+    clock->setVisible(true);
+    clock->m_LastActivity.start();
+    clock->m_Timer.start(delay, clock);
+}
+
+void CursorBlinkClock::hold(QWidget* widget)
+{
+    CursorBlinkClockTimer* clock = CursorBlinkClockTimer::instance();
+    if (clock->m_Widget != widget)
+        return;
+
+    clock->m_Timer.stop();
+    clock->setVisible(true);
+}
+
+void CursorBlinkClock::stop(QWidget* widget)
+{
+    CursorBlinkClockTimer* clock = CursorBlinkClockTimer::instance();
+    if (clock->m_Widget != widget)
+        return;
+
+    clock->m_Timer.stop();
+    clock->m_Widget  = nullptr;
+    clock->m_Visible = true;
+}
+
+bool CursorBlinkClock::cursorVisible(const QWidget* widget)
+{
+    const CursorBlinkClockTimer* clock = CursorBlinkClockTimer::instance();
+    return clock->m_Widget != widget || clock->m_Visible;
+}
@@ -0,0 +1,69 @@
+/*
+ * Copyright (c) 2021 Victor Wåhlström
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ * claim that you wrote the original software. If you use this software
+ * in a product, an acknowledgment in the product documentation would be
+ * appreciated but is not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source
+ */
+
+
+#ifndef CURSORBLINKCLOCK_H
+#define CURSORBLINKCLOCK_H
+
+#include <QtGlobal>
+
+class QWidget;
+
+/**
+ * @brief Process-wide clock driving the text cursor of the widget currently being edited
+ *
+ * Only one widget can have keyboard focus, so a single timer is enough for all of them. The cursor is shown solid
+ * for a while after each activity, then blinks until the window is deactivated or no activity has been reported for
+ * a while, after which the clock stops and the cursor stays solid.
+ *
+ * @note Must only be used from the GUI thread
+ */
+class CursorBlinkClock
+{
+  public:
+    /**
+     * @brief Make a widget the subscriber of the clock and report activity
+     * @param widget The widget being edited, replacing any previous subscriber
+     * @param delay Time in milliseconds the cursor is shown solid before it starts blinking
+     *
+     * The widget is repainted whenever the cursor visibility changes.
+     */
+    static void activity(QWidget* widget, int delay);
+
+    /**
+     * @brief Show the cursor solid until the next activity, e.g. while selecting text with the mouse
+     */
+    static void hold(QWidget* widget);
+
+    /**
+     * @brief Unsubscribe a widget. Does nothing if the widget is not the current subscriber.
+     */
+    static void stop(QWidget* widget);
+
+    /**
+     * @brief Get the cursor visibility for a widget
+     * @return true unless widget is the subscriber and the cursor is in the hidden phase of a blink
+     */
+    static bool cursorVisible(const QWidget* widget);
+};
+
+#endif // CURSORBLINKCLOCK_H
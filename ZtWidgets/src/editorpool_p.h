@@ -0,0 +1,124 @@
+/*
+ * Copyright (c) 2021 Victor Wåhlström
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ * claim that you wrote the original software. If you use this software
+ * in a product, an acknowledgment in the product documentation would be
+ * appreciated but is not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source
+ */
+
+
+#ifndef EDITORPOOL_H
+#define EDITORPOOL_H
+
+#include <QPointer>
+#include <QVector>
+#include <QWidget>
+
+/**
+ * @brief Idle item view editors kept for reuse by a delegate
+ *
+ * Item views destroy their editor whenever editing moves to another cell. A delegate instead gives the editor back to
+ * its pool in destroyEditor(), and takes it out again in createEditor(), so moving between cells neither allocates nor
+ * builds a new widget. Idle editors stay hidden children of the view they were last used by, and are deleted along
+ * with it.
+ */
+template<typename Editor>
+class EditorPool
+{
+    Q_DISABLE_COPY(EditorPool)
+
+  public:
+    /**
+     * @brief Default number of idle editors kept
+     */
+    static constexpr const int DefaultCapacity = 2;
+
+    EditorPool()
+        : m_Capacity(DefaultCapacity)
+    {}
+
+    ~EditorPool() { clear(); }
+
+    /**
+     * @brief Take an idle editor
+     * @param parent The widget the editor is shown in
+     * @return An idle editor moved to parent, or nullptr if the pool is empty
+     */
+    Editor* take(QWidget* parent)
+    {
+        while (!m_Idle.isEmpty())
+        {
+            // editors are deleted along with the view they were last used by
+            Editor* editor = m_Idle.takeLast();
+            if (!editor)
+                continue;
+
+            if (editor->parentWidget() != parent)
+                editor->setParent(parent);
+
+            return editor;
+        }
+
+        return nullptr;
+    }
+
+    /**
+     * @brief Give an editor which is no longer used to the pool
+     * @return false if the pool is full, in which case the caller remains responsible for the editor
+     */
+    bool give(Editor* editor)
+    {
+        m_Idle.removeAll(QPointer<Editor>());
+        if (m_Idle.size() >= m_Capacity)
+            return false;
+
+        m_Idle.append(editor);
+        return true;
+    }
+
+    /**
+     * @brief Set the number of idle editors kept. Excess editors are deleted.
+     */
+    void setCapacity(int capacity)
+    {
+        m_Capacity = qMax(0, capacity);
+        while (m_Idle.size() > m_Capacity)
+            delete m_Idle.takeLast().data();
+    }
+
+    /**
+     * @brief Number of idle editors kept
+     */
+    int capacity() const { return m_Capacity; }
+
+    /**
+     * @brief Delete all idle editors
+     */
+    void clear()
+    {
+        for (const QPointer<Editor>& editor : qAsConst(m_Idle))
+            delete editor.data();
+
+        m_Idle.clear();
+    }
+
+  private:
+    QVector<QPointer<Editor>> m_Idle;
+    int m_Capacity;
+};
+
+#endif // EDITORPOOL_H
@@ -0,0 +1,144 @@
+/*
+ * Copyright (c) 2021 Victor Wåhlström
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ * claim that you wrote the original software. If you use this software
+ * in a product, an acknowledgment in the product documentation would be
+ * appreciated but is not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source
+ */
+
+
+#include "frameclock_p.h"
+
+#include <QBasicTimer>
+#include <QCoreApplication>
+#include <QPointer>
+#include <QTimerEvent>
+#include <QVector>
+
+#include <algorithm>
+
+//! @cond Doxygen_Suppress
+class FrameClockTimer : public QObject
+{
+    Q_DISABLE_COPY(FrameClockTimer)
+
+  public:
+    struct Subscriber
+    {
+        const void* key;
+        std::function<void()> tick;
+    };
+
+    explicit FrameClockTimer(QObject* parent);
+
+    static FrameClockTimer* instance(bool create);
+
+    void compact();
+
+    QVector<Subscriber> m_Subscribers;
+    QBasicTimer m_Timer;
+    bool m_Ticking;
+
+  protected:
+    void timerEvent(QTimerEvent* event) override;
+};
+
+FrameClockTimer::FrameClockTimer(QObject* parent)
+    : QObject(parent)
+    , m_Ticking(false)
+{}
+
+FrameClockTimer* FrameClockTimer::instance(bool create)
+{
+    // owned by the application object, like the other process-wide resources
+    static QPointer<FrameClockTimer> s_Clock;
+    if (!s_Clock && create)
+        s_Clock = new FrameClockTimer(QCoreApplication::instance());
+
+    return s_Clock;
+}
+
+void FrameClockTimer::compact()
+{
+    // unsubscribing during a tick only clears the key, so that the tick loop is not disturbed
+    auto it = std::remove_if(
+        m_Subscribers.begin(), m_Subscribers.end(), [](const Subscriber& s) { return s.key == nullptr; });
+    m_Subscribers.erase(it, m_Subscribers.end());
+
+    if (m_Subscribers.isEmpty())
+        m_Timer.stop();
+}
+
+void FrameClockTimer::timerEvent(QTimerEvent* event)
+{
+    if (event->timerId() != m_Timer.timerId())
+    {
+        QObject::timerEvent(event);
+        return;
+    }
+
+    // subscribers added during the tick are called from the next one
+    m_Ticking       = true;
+    const int count = m_Subscribers.size();
+    for (int i = 0; i < count; ++i)
+    {
+        // a copy, as the tick may subscribe others and reallocate the list while it runs
+        if (m_Subscribers[i].key)
+        {
+            const std::function<void()> tick = m_Subscribers[i].tick;
+            tick();
+        }
+    }
+    m_Ticking = false;
+
+    compact();
+}
+//! @endcond
+
+void FrameClock::subscribe(const void* subscriber, const std::function<void()>& tick)
+{
+    FrameClockTimer* clock = FrameClockTimer::instance(true);
+    for (FrameClockTimer::Subscriber& s : clock->m_Subscribers)
+    {
+        if (s.key == subscriber)
+        {
+            s.tick = tick;
+            return;
+        }
+    }
+
+    clock->m_Subscribers.append({subscriber, tick});
+    if (!clock->m_Timer.isActive())
+        clock->m_Timer.start(Interval, clock);
+}
+
+void FrameClock::unsubscribe(const void* subscriber)
+{
+    // the clock may already be gone when widgets are destroyed after the application object
+    FrameClockTimer* clock = FrameClockTimer::instance(false);
+    if (!clock)
+        return;
+
+    for (FrameClockTimer::Subscriber& s : clock->m_Subscribers)
+    {
+        if (s.key == subscriber)
+            s.key = nullptr;
+    }
+
+    if (!clock->m_Ticking)
+        clock->compact();
+}
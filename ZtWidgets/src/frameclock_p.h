@@ -0,0 +1,58 @@
+/*
+ * Copyright (c) 2021 Victor Wåhlström
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ * claim that you wrote the original software. If you use this software
+ * in a product, an acknowledgment in the product documentation would be
+ * appreciated but is not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source
+ */
+
+
+#ifndef FRAMECLOCK_H
+#define FRAMECLOCK_H
+
+#include <functional>
+
+/**
+ * @brief Process-wide clock calling subscribers once per display frame
+ *
+ * Used by widgets which poll data written by other threads, so that any number of them share a single timer. The
+ * timer only runs while there are subscribers.
+ *
+ * @note Must only be used from the GUI thread
+ */
+class FrameClock
+{
+  public:
+    /**
+     * @brief Call a function once per frame until unsubscribed
+     * @param subscriber Key identifying the subscriber, usually its address. Replaces an existing subscription.
+     * @param tick Function called once per frame
+     */
+    static void subscribe(const void* subscriber, const std::function<void()>& tick);
+
+    /**
+     * @brief Stop calling a subscriber. Safe to call from within a tick.
+     */
+    static void unsubscribe(const void* subscriber);
+
+    /**
+     * @brief Frame interval in milliseconds
+     */
+    static constexpr const int Interval = 16;
+};
+
+#endif // FRAMECLOCK_H
@@ -26,27 +26,6 @@
 #include <QtGui/QPainter>
 #include <QtGui/QPainterPath>
 
-static QRect fittedSquare(const QRect& rect)
-{
-    QRect square(rect);
-
-    int w = square.width();
-    int h = square.height();
-    if (w > h)
-    {
-        int offset = (w - h) / 2;
-        square.setWidth(h);
-        square.moveLeft(square.left() + offset);
-    }
-    else
-    {
-        int offset = (h - w) / 2;
-        square.setHeight(w);
-        square.moveTop(square.top() + offset);
-    }
-    return square;
-}
-
 //! @cond Doxygen_Suppress
 class HueSaturationWheelPrivate
 {
@@ -74,71 +53,25 @@ HueSaturationWheelPrivate::HueSaturationWheelPrivate(HueSaturationWheel* hs_whee
 
 void HueSaturationWheelPrivate::updateMarkerPos()
 {
-    QRect square = fittedSquare(m_HueSaturationWheelPrivate->rect());
-    qreal radius = square.width() * 0.5;
-    qreal h      = m_Color.hsvHueF();
-    qreal s      = m_Color.hsvSaturationF();
-
-    qreal distance = s * radius;
-
-    QPoint center = square.center();
-    QLineF line(center.x(), center.y(), center.x(), center.y() + distance);
-    line.setAngle(360.0 - h * 360.0 - 90.0);
-    m_markerPos = line.p2();
+    QRect square = HueSaturationWheel::fittedSquare(m_HueSaturationWheelPrivate->rect());
+    m_markerPos  = HueSaturationWheel::markerPos(square, m_Color);
 }
 
 void HueSaturationWheelPrivate::rebuildColorWheel()
 {
-    QRect square = fittedSquare(m_HueSaturationWheelPrivate->rect());
+    QRect square = HueSaturationWheel::fittedSquare(m_HueSaturationWheelPrivate->rect());
     m_wheelImg   = QImage(square.size(), QImage::Format_ARGB32_Premultiplied);
     m_wheelImg.fill(0);
 
-    QRect r = m_wheelImg.rect();
     QPainter painter(&m_wheelImg);
-
-    painter.save();
-    painter.setRenderHint(QPainter::Antialiasing);
-    QPen pen;
-    pen.setColor(Qt::transparent);
-    painter.setPen(pen);
-    painter.setBrush(Qt::transparent);
-    painter.drawRect(r);
-
-    QPainterPath path;
-    path.addEllipse(r);
-
-    painter.setClipPath(path);
-
-    // Calculate hue, value
-    QConicalGradient hue(r.center(), -90.0);
-    QColor color;
-    qreal step = 0.0;
-    qreal val  = m_Color.valueF();
-
-    while (step < 1.0)
-    {
-        color.setHsvF(1.0 - step, 1.0, val);
-        hue.setColorAt(step, color);
-        step += 0.1;
-    }
-    painter.fillPath(path, hue);
-
-    // Calculate saturation. May not be pixel perfect
-    qreal radius = r.width() * 0.5;
-    QRadialGradient sat(r.center(), radius);
-    color.setRgbF(val, val, val, 1.0);
-    sat.setColorAt(0, color);
-    color.setRgbF(val, val, val, 0.0);
-    sat.setColorAt(1, color);
-    painter.fillPath(path, sat);
-    painter.restore();
+    HueSaturationWheel::drawWheel(painter, m_wheelImg.rect(), m_Color.valueF());
 
     m_HueSaturationWheelPrivate->update();
 }
 
 void HueSaturationWheelPrivate::updateColor(const QPointF& pos)
 {
-    QRect square = fittedSquare(m_HueSaturationWheelPrivate->rect());
+    QRect square = HueSaturationWheel::fittedSquare(m_HueSaturationWheelPrivate->rect());
 
     qreal radius = square.width() * 0.5;
     QLineF line(square.center(), pos);
@@ -183,18 +116,9 @@ void HueSaturationWheel::updateColor(const QColor& color)
     int old_value = m_Impl->m_Color.value();
 
     QRect square = fittedSquare(rect());
-    qreal radius = square.width() * 0.5;
-    qreal h      = color.hsvHueF();
-    qreal s      = color.hsvSaturationF();
     m_Impl->m_Color.setRgba(color.rgba());
 
-    qreal distance = s * radius;
-    QPoint center  = square.center();
-
-    QLineF line(center.x(), center.y(), center.x(), center.y() + distance);
-    line.setAngle(360.0 - h * 360.0 - 90.0);
-
-    m_Impl->updateColor(line.p2());
+    m_Impl->updateColor(markerPos(square, color));
     m_Impl->updateMarkerPos();
     if (old_value != color.value())
     {
@@ -249,15 +173,89 @@ void HueSaturationWheel::paintEvent(QPaintEvent*)
 
     QRect square = fittedSquare(rect());
     painter.drawImage(square, m_Impl->m_wheelImg);
+    drawMarker(painter, m_Impl->m_markerPos, m_Impl->m_Color);
+
+    painter.restore();
+}
+
+QRect HueSaturationWheel::fittedSquare(const QRect& rect)
+{
+    QRect square(rect);
+
+    int w = square.width();
+    int h = square.height();
+    if (w > h)
+    {
+        int offset = (w - h) / 2;
+        square.setWidth(h);
+        square.moveLeft(square.left() + offset);
+    }
+    else
+    {
+        int offset = (h - w) / 2;
+        square.setHeight(w);
+        square.moveTop(square.top() + offset);
+    }
+    return square;
+}
+
+void HueSaturationWheel::drawWheel(QPainter& painter, const QRect& square, qreal value)
+{
+    painter.save();
+    painter.setRenderHint(QPainter::Antialiasing);
+
+    QPainterPath path;
+    path.addEllipse(square);
+
+    painter.setClipPath(path, Qt::IntersectClip);
+
+    // Calculate hue, value
+    QConicalGradient hue(square.center(), -90.0);
+    QColor color;
+    qreal step = 0.0;
+
+    while (step < 1.0)
+    {
+        color.setHsvF(1.0 - step, 1.0, value);
+        hue.setColorAt(step, color);
+        step += 0.1;
+    }
+    painter.fillPath(path, hue);
+
+    // Calculate saturation. May not be pixel perfect
+    qreal radius = square.width() * 0.5;
+    QRadialGradient sat(square.center(), radius);
+    color.setRgbF(value, value, value, 1.0);
+    sat.setColorAt(0, color);
+    color.setRgbF(value, value, value, 0.0);
+    sat.setColorAt(1, color);
+    painter.fillPath(path, sat);
+    painter.restore();
+}
 
+QPointF HueSaturationWheel::markerPos(const QRect& square, const QColor& color)
+{
+    qreal radius = square.width() * 0.5;
+    qreal h      = color.hsvHueF();
+    qreal s      = color.hsvSaturationF();
+
+    qreal distance = s * radius;
+
+    QPoint center = square.center();
+    QLineF line(center.x(), center.y(), center.x(), center.y() + distance);
+    line.setAngle(360.0 - h * 360.0 - 90.0);
+    return line.p2();
+}
+
+void HueSaturationWheel::drawMarker(QPainter& painter, const QPointF& pos, const QColor& color)
+{
     QPen pen;
-    QColor marker_color = m_Impl->m_Color.valueF() > 0.5 ? Qt::black : Qt::white;
+    QColor marker_color = color.valueF() > 0.5 ? Qt::black : Qt::white;
     pen.setColor(marker_color);
 
     painter.setPen(pen);
-    QRectF marker(m_Impl->m_markerPos.x() - 2, m_Impl->m_markerPos.y() - 2, 5, 5);
+    painter.setBrush(Qt::NoBrush);
+    QRectF marker(pos.x() - 2, pos.y() - 2, 5, 5);
     // arcs are specified in 1/16 degrees; draw a full circle
     painter.drawArc(marker, 0, 360 * 16);
-
-    painter.restore();
 }
@@ -26,6 +26,7 @@
 #include <QWidget>
 
 class HueSaturationWheelPrivate;
+class QPainter;
 
 /**
  * @brief A color wheel for controlling hue and saturation
@@ -63,6 +64,37 @@ class HueSaturationWheel : public QWidget
      */
     void setColor(const QColor& color);
 
+    /**
+     * @brief Get the largest square centered in a rectangle
+     * @param rect The rectangle to fit the square in
+     * @return The fitted square
+     */
+    static QRect fittedSquare(const QRect& rect);
+
+    /**
+     * @brief Draw the hue and saturation wheel
+     * @param painter The painter to draw with
+     * @param square Bounds of the wheel
+     * @param value HSV value of the colors in the wheel
+     */
+    static void drawWheel(QPainter& painter, const QRect& square, qreal value);
+
+    /**
+     * @brief Get the position of the marker for a color
+     * @param square Bounds of the wheel
+     * @param color The color to mark
+     * @return Center of the marker
+     */
+    static QPointF markerPos(const QRect& square, const QColor& color);
+
+    /**
+     * @brief Draw the marker for a color
+     * @param painter The painter to draw with
+     * @param pos Center of the marker
+     * @param color The marked color, which decides the color of the marker
+     */
+    static void drawMarker(QPainter& painter, const QPointF& pos, const QColor& color);
+
   protected:
     /**
      * @brief Reimplemented from QWidget::updateColor()
@@ -0,0 +1,140 @@
+/*
+ * Copyright (c) 2021 Victor Wåhlström
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ * claim that you wrote the original software. If you use this software
+ * in a product, an acknowledgment in the product documentation would be
+ * appreciated but is not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source
+ */
+
+
+#include "numberformat_p.h"
+
+#include <QLocale>
+#include <QtMath>
+
+// every power of ten up to 10^22 is exactly representable as a double
+static constexpr const qreal S_POW10[] = {1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+                                          1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+static constexpr const quint32 S_POW10_COUNT = sizeof(S_POW10) / sizeof(S_POW10[0]);
+
+// largest integer below which every integer is exactly representable as a double
+static constexpr const qreal S_MAX_EXACT_INTEGER = 9007199254740992.0;
+
+NumberFormat::Separators::Separators()
+    : decimalPoint(QLatin1Char('.'))
+    , groupSeparator(QLatin1Char(','))
+    , negativeSign(QLatin1Char('-'))
+    , grouping(false)
+{}
+
+NumberFormat::Separators::Separators(const QLocale& locale)
+    : decimalPoint(locale.decimalPoint())
+    , groupSeparator(locale.groupSeparator())
+    , negativeSign(locale.negativeSign())
+    , grouping(!(locale.numberOptions() & QLocale::OmitGroupSeparator))
+{}
+
+qreal NumberFormat::pow10(quint32 exponent)
+{
+    return exponent < S_POW10_COUNT ? S_POW10[exponent] : qPow(10, exponent);
+}
+
+qreal NumberFormat::snapToPrecision(qreal value, quint32 precision)
+{
+    const qreal p = pow10(precision);
+    return qRound64(value * p) / p;
+}
+
+int NumberFormat::formatFixed(qreal value, quint32 precision, QChar* out, const Separators& separators)
+{
+    if (!qIsFinite(value) || precision > static_cast<quint32>(MaxPrecision))
+        return -1;
+
+    const qreal scaled = qAbs(value) * S_POW10[precision];
+    if (scaled >= S_MAX_EXACT_INTEGER)
+        return -1;
+
+    quint64 n = static_cast<quint64>(scaled + 0.5);
+
+    // a value which rounds to zero is printed without a sign
+    const bool negative = value < 0 && n != 0;
+
+    // digits in reverse order, padded with zeros so that there is at least one digit before the decimal point
+    char digits[MaxPrecision + 2];
+    int count = 0;
+    do
+    {
+        digits[count++] = static_cast<char>('0' + n % 10);
+        n /= 10;
+    } while (n != 0);
+
+    const int decimals = static_cast<int>(precision);
+    while (count <= decimals)
+        digits[count++] = '0';
+
+    int pos = 0;
+    if (negative)
+        out[pos++] = separators.negativeSign;
+
+    for (int i = count - 1; i >= decimals; --i)
+    {
+        out[pos++] = QLatin1Char(digits[i]);
+
+        const int remaining = i - decimals;
+        if (separators.grouping && remaining > 0 && remaining % 3 == 0)
+            out[pos++] = separators.groupSeparator;
+    }
+
+    if (decimals > 0)
+    {
+        out[pos++] = separators.decimalPoint;
+        for (int i = decimals - 1; i >= 0; --i)
+            out[pos++] = QLatin1Char(digits[i]);
+    }
+
+    return pos;
+}
+
+QString NumberFormat::toString(qreal value, quint32 precision, const Separators& separators)
+{
+    QChar buffer[MaxLength];
+    const int length = formatFixed(value, precision, buffer, separators);
+    if (length >= 0)
+        return QString(buffer, length);
+
+    QLocale locale = QLocale::c();
+    if (separators.grouping)
+        locale.setNumberOptions(QLocale::DefaultNumberOptions);
+
+    QString text = locale.toString(value, 'f', static_cast<int>(qMin(precision, 99u)));
+    if (separators.decimalPoint != locale.decimalPoint() || separators.groupSeparator != locale.groupSeparator() ||
+        separators.negativeSign != locale.negativeSign())
+    {
+        // swap the C locale characters for the requested ones in a single pass
+        for (QChar& c : text)
+        {
+            if (c == locale.decimalPoint())
+                c = separators.decimalPoint;
+            else if (c == locale.groupSeparator())
+                c = separators.groupSeparator;
+            else if (c == locale.negativeSign())
+                c = separators.negativeSign;
+        }
+    }
+
+    return text;
+}
@@ -0,0 +1,107 @@
+/*
+ * Copyright (c) 2021 Victor Wåhlström
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ * claim that you wrote the original software. If you use this software
+ * in a product, an acknowledgment in the product documentation would be
+ * appreciated but is not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source
+ */
+
+
+#ifndef NUMBERFORMAT_H
+#define NUMBERFORMAT_H
+
+#include <QChar>
+#include <QString>
+
+class QLocale;
+
+/**
+ * @brief Fixed precision number formatting without temporary allocations
+ *
+ * Values are scaled by a power of ten from a constant table, rounded to an integer and written digit by digit into
+ * a caller-provided buffer. Values that can't be represented exactly that way are formatted by QLocale instead.
+ */
+class NumberFormat
+{
+  public:
+    /**
+     * @brief Characters used when formatting a number
+     */
+    struct Separators
+    {
+        /**
+         * @brief Construct separators for the C locale, without digit grouping
+         */
+        Separators();
+
+        /**
+         * @brief Construct separators matching a locale
+         * @param locale The locale to match
+         */
+        explicit Separators(const QLocale& locale);
+
+        QChar decimalPoint;
+        QChar groupSeparator;
+        QChar negativeSign;
+        bool grouping;
+    };
+
+    /**
+     * @brief Number of characters needed to hold the output of formatFixed()
+     */
+    static constexpr const int MaxLength = 48;
+
+    /**
+     * @brief Highest precision handled by formatFixed()
+     */
+    static constexpr const int MaxPrecision = 17;
+
+    /**
+     * @brief Get a power of ten
+     * @param exponent A non-negative exponent
+     * @return 10 raised to exponent, from a table for all exponents which are exactly representable
+     */
+    static qreal pow10(quint32 exponent);
+
+    /**
+     * @brief Round a value to a number of decimals
+     * @param value The value to round
+     * @param precision Number of decimals
+     * @return The rounded value
+     */
+    static qreal snapToPrecision(qreal value, quint32 precision);
+
+    /**
+     * @brief Format a value with a fixed number of decimals
+     * @param value The value to format
+     * @param precision Number of decimals
+     * @param out Output buffer. Must be able to hold MaxLength characters.
+     * @param separators Characters to use for the decimal point, digit grouping and sign
+     * @return The number of characters written to the buffer, or -1 if the value is not finite, the precision is
+     * higher than MaxPrecision, or the scaled value is too large to be represented exactly
+     */
+    static int formatFixed(qreal value, quint32 precision, QChar* out, const Separators& separators = Separators());
+
+    /**
+     * @brief Format a value with a fixed number of decimals
+     *
+     * Uses formatFixed() when possible, and falls back to QLocale otherwise.
+     */
+    static QString toString(qreal value, quint32 precision, const Separators& separators = Separators());
+};
+
+#endif // NUMBERFORMAT_H
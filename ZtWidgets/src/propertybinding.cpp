@@ -0,0 +1,190 @@
+/*
+ * Copyright (c) 2021 Victor Wåhlström
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ * claim that you wrote the original software. If you use this software
+ * in a product, an acknowledgment in the product documentation would be
+ * appreciated but is not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source
+ */
+
+
+#include "propertybinding_p.h"
+
+#include "frameclock_p.h"
+
+#include <QMetaMethod>
+
+SliderPropertyBinding* SliderPropertyBinding::create(SliderEdit* slider,
+                                                     QObject* object,
+                                                     const char* name,
+                                                     SliderEdit::PropertyBinding options)
+{
+    if (!object || !name)
+        return nullptr;
+
+    const QMetaObject* meta_object = object->metaObject();
+    const int index                = meta_object->indexOfProperty(name);
+    if (index < 0)
+        return nullptr;
+
+    const QMetaProperty property = meta_object->property(index);
+    if (!property.isReadable() || (!(options & SliderEdit::ReadOnlyBinding) && !property.isWritable()))
+        return nullptr;
+
+    bool numeric = false;
+    property.read(object).toDouble(&numeric);
+    if (!numeric)
+        return nullptr;
+
+    return new SliderPropertyBinding(slider, object, property, options);
+}
+
+SliderPropertyBinding::SliderPropertyBinding(SliderEdit* slider,
+                                             QObject* object,
+                                             const QMetaProperty& property,
+                                             SliderEdit::PropertyBinding options)
+    : QObject(slider)
+    , m_Slider(slider)
+    , m_Object(object)
+    , m_Property(property)
+    , m_Value(0.0)
+    , m_PendingValue(0.0)
+    , m_Options(options)
+    , m_Writing(false)
+    , m_ReadPending(false)
+    , m_WritePending(false)
+{
+    // resolved once for all bindings
+    static const QMetaMethod s_PropertyChanged =
+        staticMetaObject.method(staticMetaObject.indexOfSlot("propertyChanged()"));
+
+    if (property.hasNotifySignal())
+        connect(object, property.notifySignal(), this, s_PropertyChanged);
+
+    if (!(options & SliderEdit::ReadOnlyBinding))
+    {
+        connect(slider, &SliderEdit::valueChanging, this, &SliderPropertyBinding::sliderChanging);
+        connect(slider, &SliderEdit::valueChanged, this, &SliderPropertyBinding::sliderChanged);
+    }
+
+    readProperty();
+}
+
+SliderPropertyBinding::~SliderPropertyBinding()
+{
+    // does nothing unless subscribed
+    FrameClock::unsubscribe(this);
+}
+
+QObject* SliderPropertyBinding::object() const
+{
+    return m_Object;
+}
+
+void SliderPropertyBinding::propertyChanged()
+{
+    // our own write coming back
+    if (m_Writing)
+        return;
+
+    if (m_Options & SliderEdit::CoalesceChanges)
+    {
+        schedule();
+        m_ReadPending = true;
+    }
+    else
+    {
+        readProperty();
+    }
+}
+
+void SliderPropertyBinding::sliderChanging(qreal value)
+{
+    if (m_Options & SliderEdit::CoalesceChanges)
+    {
+        schedule();
+        m_PendingValue = value;
+        m_WritePending = true;
+    }
+    else
+    {
+        writeProperty(value);
+    }
+}
+
+void SliderPropertyBinding::sliderChanged(qreal value)
+{
+    // the final value of an interaction is never deferred
+    m_WritePending = false;
+    if (!m_ReadPending)
+        FrameClock::unsubscribe(this);
+
+    writeProperty(value);
+}
+
+void SliderPropertyBinding::readProperty()
+{
+    m_ReadPending = false;
+    if (!m_Object)
+        return;
+
+    const qreal value = m_Property.read(m_Object).toDouble();
+    if (value == m_Value && value == m_Slider->value())
+        return;
+
+    m_Value = value;
+    m_Slider->updateValue(value);
+}
+
+void SliderPropertyBinding::writeProperty(qreal value)
+{
+    if (!m_Object || value == m_Value)
+        return;
+
+    m_Writing = true;
+    m_Property.write(m_Object, value);
+    m_Writing = false;
+
+    // the notification of our own write is ignored, so read back what the setter actually stored. It may have clamped,
+    // rounded or rejected the value.
+    m_Value = m_Property.read(m_Object).toDouble();
+    if (m_Value != value)
+        m_Slider->updateValue(m_Value);
+}
+
+void SliderPropertyBinding::schedule()
+{
+    // at most one subscription, however many changes arrive during a frame
+    if (!m_ReadPending && !m_WritePending)
+        FrameClock::subscribe(this, [this]() { flush(); });
+}
+
+void SliderPropertyBinding::flush()
+{
+    FrameClock::unsubscribe(this);
+
+    // a change made through the slider wins over one made to the property during the same frame
+    if (m_WritePending)
+    {
+        m_WritePending = false;
+        m_ReadPending  = false;
+        writeProperty(m_PendingValue);
+    }
+    else if (m_ReadPending)
+    {
+        readProperty();
+    }
+}
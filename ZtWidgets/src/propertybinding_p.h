@@ -0,0 +1,90 @@
+/*
+ * Copyright (c) 2021 Victor Wåhlström
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ * claim that you wrote the original software. If you use this software
+ * in a product, an acknowledgment in the product documentation would be
+ * appreciated but is not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source
+ */
+
+
+#ifndef PROPERTYBINDING_H
+#define PROPERTYBINDING_H
+
+#include <ZtWidgets/slideredit.h>
+
+#include <QMetaProperty>
+#include <QObject>
+#include <QPointer>
+
+/**
+ * @brief Keeps a SliderEdit and a numeric property of another object in sync
+ *
+ * The property and its notify signal are resolved once, when the binding is created, so each change costs a single
+ * QMetaProperty::read() or QMetaProperty::write() and no lookups by name.
+ */
+class SliderPropertyBinding : public QObject
+{
+    Q_OBJECT
+
+    Q_DISABLE_COPY(SliderPropertyBinding)
+
+  public:
+    /**
+     * @brief Bind a slider to a property
+     * @return The binding, owned by the slider, or nullptr if the property does not exist or can not be bound
+     */
+    static SliderPropertyBinding* create(SliderEdit* slider,
+                                         QObject* object,
+                                         const char* name,
+                                         SliderEdit::PropertyBinding options);
+
+    virtual ~SliderPropertyBinding();
+
+    /**
+     * @brief The bound object, or nullptr if it has been destroyed
+     */
+    QObject* object() const;
+
+  private Q_SLOTS:
+    void propertyChanged();
+
+  private:
+    SliderPropertyBinding(SliderEdit* slider,
+                          QObject* object,
+                          const QMetaProperty& property,
+                          SliderEdit::PropertyBinding options);
+
+    void sliderChanging(qreal value);
+    void sliderChanged(qreal value);
+    void readProperty();
+    void writeProperty(qreal value);
+    void schedule();
+    void flush();
+
+    SliderEdit* m_Slider;
+    QPointer<QObject> m_Object;
+    QMetaProperty m_Property;
+    // the last value read from or written to the property
+    qreal m_Value;
+    qreal m_PendingValue;
+    SliderEdit::PropertyBinding m_Options;
+    bool m_Writing : 1;
+    bool m_ReadPending : 1;
+    bool m_WritePending : 1;
+};
+
+#endif // PROPERTYBINDING_H
@@ -20,199 +20,274 @@
  * 3. This notice may not be removed or altered from any source
  */
 
+#include "changetracker_p.h"
+#include "cursorblinkclock_p.h"
+#include "frameclock_p.h"
+#include "numberformat_p.h"
+#include "propertybinding_p.h"
+#include "slidereditsession_p.h"
+#include "sliderhistogram_p.h"
+#include "sliderpainter_p.h"
+#include "styleresources_p.h"
+#include "valuemapping_p.h"
+
 #include <ZtWidgets/slideredit.h>
+#include <ZtWidgets/sliderhistogram.h>
+#include <ZtWidgets/slidervaluesource.h>
 
+#include <QHash>
 #include <QKeyEvent>
 #include <QPainter>
-#include <QStyleOption>
+#include <QPixmap>
+#include <QStaticText>
 #include <QTime>
-#include <QTimer>
 #include <QtMath>
 
-static constexpr const int S_DRAW_PADDING = 2;
 
-static QString toString(qreal val, quint16 precision)
+// time the edit cursor is shown solid before it starts blinking, when entering edit mode and after any other input
+static constexpr const int S_CURSOR_BLINK_DELAY    = 1000;
+static constexpr const int S_CURSOR_ACTIVITY_DELAY = 500;
+
+// the top left position of a block of text aligned within a rectangle, the way QPainter::drawText() would place it
+static QPointF alignedPosition(const QRect& rect, const QSizeF& size, Qt::Alignment alignment)
 {
-    return QString("%1").arg(val, 0, 'f', precision, '0');
+    qreal x = rect.x();
+    if (alignment & Qt::AlignRight)
+        x = rect.x() + rect.width() - size.width();
+    else if (alignment & Qt::AlignHCenter)
+        x = rect.x() + (rect.width() - size.width()) * 0.5;
+
+    qreal y = rect.y();
+    if (alignment & Qt::AlignBottom)
+        y = rect.y() + rect.height() - size.height();
+    else if (alignment & Qt::AlignVCenter)
+        y = rect.y() + (rect.height() - size.height()) * 0.5;
+
+    return QPointF(x, y);
 }
 
-static qreal snapToPrecision(qreal value, quint32 precision)
+// labels and units repeat across panels of sliders, so share a single copy of each distinct string. Each string is
+// counted by the sliders using it, and dropped along with the last of them.
+static QHash<QString, int>& internedStrings()
 {
-    const qreal p = qPow(10, precision);
-    return qRound64(value * p) / p;
+    static QHash<QString, int> s_Strings;
+    return s_Strings;
 }
 
-static qreal mapToPosition(SliderEdit::ValueMapping map_type,
-                           qreal val,
-                           qreal min_val,
-                           qreal max_val,
-                           qreal min_pos,
-                           qreal max_pos)
+static QString acquireString(const QString& string)
 {
-    qreal pos = 0;
-    switch (map_type)
-    {
-        case SliderEdit::ValueMapping::LinearScale:
-        {
-            const qreal scale = (val - min_val) / (max_val - min_val);
-            pos               = min_pos + scale * (max_pos - min_pos);
-        }
-        break;
-        case SliderEdit::ValueMapping::LogarithmicScale:
-        {
-            const qreal offset  = min_val < 1 ? 1 - min_val : 0;
-            const qreal log_min = qLn(min_val + offset);
-            const qreal log_max = qLn(max_val + offset);
-            const qreal scale   = (log_max - log_min) / (max_pos - min_pos);
-            pos                 = (qLn(val + offset) - log_min) / scale + min_pos;
-        }
-        break;
-    }
+    if (string.isEmpty())
+        return QString();
+
+    QHash<QString, int>& strings = internedStrings();
+    auto it                      = strings.find(string);
+    if (it == strings.end())
+        it = strings.insert(string, 0);
 
-    return pos;
+    ++it.value();
+    return it.key();
 }
 
-static qreal mapFromPosition(SliderEdit::ValueMapping map_type,
-                             qreal pos,
-                             qreal min_val,
-                             qreal max_val,
-                             qreal min_pos,
-                             qreal max_pos)
+static void releaseString(const QString& string)
 {
-    qreal val = 0;
-
-    switch (map_type)
-    {
-        case SliderEdit::ValueMapping::LinearScale:
-            val = pos / (max_pos - min_pos) * (max_val - min_val) + min_val;
-            break;
-        case SliderEdit::ValueMapping::LogarithmicScale:
-        {
-            const qreal offset  = min_val < 1 ? 1 - min_val : 0;
-            const qreal log_min = qLn(min_val + offset);
-            const qreal log_max = qLn(max_val + offset);
-            const qreal scale   = (log_max - log_min) / (max_pos - min_pos);
-            val                 = qExp(log_min + scale * (pos - min_pos)) - offset;
-        }
-        break;
-    }
+    if (string.isEmpty())
+        return;
 
-    return val;
+    QHash<QString, int>& strings = internedStrings();
+    auto it                      = strings.find(string);
+    if (it != strings.end() && --it.value() == 0)
+        strings.erase(it);
 }
 
 //! @cond Doxygen_Suppress
+// values coming from outside the widget; allocated when the first feed or binding is attached
+struct SliderEditFeeds
+{
+    SliderEditFeeds()
+        : binding(nullptr)
+        , stripGeneration(0)
+        , stripColor(0)
+    {}
+
+    // a child of the widget, so that it goes away with it
+    SliderPropertyBinding* binding;
+    // written by other threads and read once per frame
+    QSharedPointer<SliderValueSource> valueSource;
+    QSharedPointer<SliderHistogram> histogram;
+    // the histogram drawn at the size of the track, redrawn when the bins change
+    QPixmap strip;
+    quint32 stripGeneration;
+    QRgb stripColor;
+};
+
 class SliderEditPrivate
 {
     Q_DISABLE_COPY(SliderEditPrivate)
 
   public:
     explicit SliderEditPrivate(SliderEdit*);
+    ~SliderEditPrivate();
 
     void beginEdit();
     void endEdit();
     void cancelEdit();
     bool isEditing() const;
+    qreal editTextOrigin() const;
     quint32 toEditCursorPos(int pos) const;
     qreal valueFromMousePos(const QPointF& pos) const;
-
+    void finishKeyStepping();
+    void invalidateText();
+    void updateMapping();
+    void updateSeparators();
+    QString toString(qreal value, bool grouping = true) const;
+    void updateDisplayText(const QFont& font, qreal device_pixel_ratio);
+    void drawDisplayText(QPainter& painter, const QRect& rect) const;
+    QRect displayTextBounds(const QRect& rect) const;
+    QRect drawRect() const;
+    int gaugePosition(qreal value, int extent) const;
+    QRect gaugeStrip(qreal from, qreal to) const;
+    void invalidateValue(qreal old_value);
+    void requestUpdate();
+    bool isMeter() const;
+    void pollFeeds();
+    void updateFeedSubscription();
+    void drawHistogram(QPainter& painter, const QRect& rect);
+
+    // members are ordered to avoid padding; see the size budget below
     QString m_Label;
     QString m_Unit;
-    QString m_EditText;
-    QString m_Text;
-    QTimer m_AnimEditCursorActivationTimer;
-    QTimer m_AnimEditCursorBlinkTimer;
+    SliderEditSession* m_Edit;
+    SliderEditFeeds* m_Feeds;
     QPoint m_MousePressPos;
-    quint32 m_EditTextCurPos;
-    qint32 m_EditTextSelOffset;
+    ChangeTracker m_Tracker;
+    NumberFormat::Separators m_Separators;
+    ValueMapper m_Mapper;
+    // laid out display text, rebuilt when the value, label, unit, precision or font changes
+    QStaticText m_LabelStaticText;
+    QStaticText m_ValueStaticText;
+    QFont m_StaticTextFont;
+    qreal m_StaticTextValue;
+    qreal m_StaticTextDevicePixelRatio;
+    QSize m_SizeHint;
     qreal m_Value;
     qreal m_Min;
     qreal m_Max;
     qreal m_SingleStep;
     qreal m_PageStep;
+    qreal m_MappingExponent;
+    qreal m_BatchStartValue;
     quint32 m_Precision;
     Qt::Alignment m_Alignment;
-    Qt::Orientation m_Orientation;
     SliderEdit::SliderComponents m_SliderComponents;
     SliderEdit::SliderBehavior m_SliderBehavior;
-    SliderEdit::ValueMapping m_ValueMapping;
+    // one bit wider than the largest value, as some compilers treat enum bit fields as signed
+    Qt::Orientation m_Orientation : 3;
+    SliderEdit::ValueMapping m_ValueMapping : 4;
+    uint m_BatchDepth : 8;
     bool m_Editable : 1;
-    bool m_AnimEditCursor : 1;
-    bool m_AnimEditCursorVisible : 1;
+    bool m_KeyStepping : 1;
+    bool m_LocalizedNumbers : 1;
+    bool m_StaticTextValid : 1;
+    bool m_SizeHintValid : 1;
+    bool m_BatchValueChanged : 1;
+    bool m_BatchDirty : 1;
 
   private:
     SliderEdit* m_SliderEdit;
 };
 
+// Panels with thousands of sliders pay for every byte here. The budget does not count ChangeTracker, whose
+// std::function differs in size between standard libraries. Rarely used state belongs in a lazily allocated object
+// like SliderEditSession rather than here. The ZtWidgetsFootprint example measures the heap used per slider; compare
+// its output before and after changing this class.
+static_assert(sizeof(SliderEditPrivate) <= sizeof(ChangeTracker) + 288,
+              "SliderEditPrivate exceeds its size budget");
+
 SliderEditPrivate::SliderEditPrivate(SliderEdit* slider_edit)
-    : m_EditTextCurPos(0)
-    , m_EditTextSelOffset(0)
+    : m_Edit(nullptr)
+    , m_Feeds(nullptr)
+    , m_Tracker([this]() { Q_EMIT m_SliderEdit->valueChanging(m_Value); })
+    , m_StaticTextValue(0.0)
+    , m_StaticTextDevicePixelRatio(1.0)
     , m_Value(0.0)
     , m_Min(0.0)
     , m_Max(1.0)
     , m_SingleStep(1.0)
     , m_PageStep(10.0)
+    , m_MappingExponent(2.0)
+    , m_BatchStartValue(0.0)
     , m_Precision(3)
     , m_Alignment(Qt::AlignCenter)
-    , m_Orientation(Qt::Horizontal)
     , m_SliderComponents(SliderEdit::SliderComponent::Text | SliderEdit::SliderComponent::Gauge)
     , m_SliderBehavior()
+    , m_Orientation(Qt::Horizontal)
     , m_ValueMapping(SliderEdit::ValueMapping::LinearScale)
+    , m_BatchDepth(0)
     , m_Editable(true)
-    , m_AnimEditCursor(true)
-    , m_AnimEditCursorVisible(true)
+    , m_KeyStepping(false)
+    , m_LocalizedNumbers(false)
+    , m_StaticTextValid(false)
+    , m_SizeHintValid(false)
+    , m_BatchValueChanged(false)
+    , m_BatchDirty(false)
     , m_SliderEdit(slider_edit)
 {
-    QObject::connect(&m_AnimEditCursorActivationTimer,
-                     &QTimer::timeout,
-                     [this]()
-                     {
-                         m_AnimEditCursor = true;
-                         m_SliderEdit->update();
-                     });
+    m_LabelStaticText.setTextFormat(Qt::PlainText);
+    m_ValueStaticText.setTextFormat(Qt::PlainText);
+}
+
+SliderEditPrivate::~SliderEditPrivate()
+{
+    if (m_Feeds)
+    {
+        FrameClock::unsubscribe(this);
+        delete m_Feeds->binding;
+    }
+
+    delete m_Feeds;
+    delete m_Edit;
 
-    QObject::connect(&m_AnimEditCursorBlinkTimer,
-                     &QTimer::timeout,
-                     [this]()
-                     {
-                         m_AnimEditCursorVisible = !m_AnimEditCursorVisible;
-                         m_SliderEdit->update();
-                     });
+    releaseString(m_Label);
+    releaseString(m_Unit);
 }
 
 void SliderEditPrivate::beginEdit()
 {
     // editing not supported (yet) when oriented vertically
-    bool editable = m_Editable && !(m_Orientation == Qt::Vertical);
+    bool editable = m_Editable && !(m_Orientation == Qt::Vertical) && !isMeter();
     if (!editable)
         return;
 
-    m_EditText          = toString(m_Value, m_Precision);
-    m_Text              = m_EditText;
-    m_EditTextCurPos    = m_EditText.size();
-    m_EditTextSelOffset = -m_EditText.size();
-    m_AnimEditCursorActivationTimer.start(1000);
-    m_AnimEditCursorBlinkTimer.start(500);
+    // digit grouping would get in the way of editing
+    delete m_Edit;
+    m_Edit = new SliderEditSession(m_SliderEdit->font(), toString(m_Value, false));
+    CursorBlinkClock::activity(m_SliderEdit, S_CURSOR_BLINK_DELAY);
     m_SliderEdit->setCursor(Qt::IBeamCursor);
 }
 
 void SliderEditPrivate::endEdit()
 {
-    if (m_Text != m_EditText)
+    if (m_Edit && m_Edit->originalText != m_Edit->text)
     {
-        bool valid;
-
-        qreal val = m_EditText.toDouble(&valid);
-        if (!valid)
+        qreal val;
+        if (!m_SliderEdit->parseValue(m_Edit->text, &val))
         {
             cancelEdit();
             return;
         }
 
-        if (m_SliderBehavior & SliderEdit::SliderBehaviorFlag::SnapToPrecision)
-            val = snapToPrecision(val, m_Precision);
-        if (!(m_SliderBehavior & SliderEdit::SliderBehaviorFlag::AllowValueUnderflow))
+        // clamped both before and after it is normalized, like values set programmatically
+        const bool clamp_min = !(m_SliderBehavior & SliderEdit::SliderBehaviorFlag::AllowValueUnderflow);
+        const bool clamp_max = !(m_SliderBehavior & SliderEdit::SliderBehaviorFlag::AllowValueOverflow);
+        if (clamp_min)
+            val = qMax(m_Min, val);
+        if (clamp_max)
+            val = qMin(m_Max, val);
+
+        val = m_SliderEdit->normalizeValue(val);
+        if (clamp_min)
             val = qMax(m_Min, val);
-        if (!(m_SliderBehavior & SliderEdit::SliderBehaviorFlag::AllowValueOverflow))
+        if (clamp_max)
             val = qMin(m_Max, val);
 
         bool changed = m_Value != val;
@@ -229,26 +304,26 @@ void SliderEditPrivate::endEdit()
 
 void SliderEditPrivate::cancelEdit()
 {
-    m_EditText          = QString();
-    m_EditTextCurPos    = 0;
-    m_EditTextSelOffset = 0;
-    m_AnimEditCursorActivationTimer.stop();
-    m_AnimEditCursorBlinkTimer.stop();
+    delete m_Edit;
+    m_Edit = nullptr;
+    CursorBlinkClock::stop(m_SliderEdit);
     m_SliderEdit->unsetCursor();
     m_SliderEdit->update();
 }
 
 bool SliderEditPrivate::isEditing() const
 {
-    return !m_EditText.isNull();
+    return m_Edit != nullptr;
+}
+
+qreal SliderEditPrivate::editTextOrigin() const
+{
+    return SliderPainter::editTextOrigin(drawRect(), *m_Edit, m_Alignment);
 }
 
 quint32 SliderEditPrivate::toEditCursorPos(int pos) const
 {
-    QFontMetrics fm(m_SliderEdit->font());
-    int cw         = fm.averageCharWidth();
-    int cursor_pos = (pos + (int)(cw * 0.5f)) / cw;
-    return static_cast<quint32>(qBound(0, cursor_pos, m_EditText.size()));
+    return static_cast<quint32>(m_Edit->cursorAt(pos - editTextOrigin()));
 }
 
 qreal SliderEditPrivate::valueFromMousePos(const QPointF& pos) const
@@ -273,7 +348,268 @@ qreal SliderEditPrivate::valueFromMousePos(const QPointF& pos) const
     }
     p = qBound(min_pos, p, max_pos);
 
-    return mapFromPosition(m_ValueMapping, p, m_Min, m_Max, min_pos, max_pos);
+    return m_Mapper.fromPosition(p, min_pos, max_pos);
+}
+
+void SliderEditPrivate::finishKeyStepping()
+{
+    if (!m_KeyStepping)
+        return;
+
+    m_KeyStepping = false;
+    m_Tracker.finish();
+    Q_EMIT m_SliderEdit->valueChanged(m_Value);
+}
+
+void SliderEditPrivate::updateMapping()
+{
+    m_Mapper.configure(m_ValueMapping, m_Min, m_Max, m_MappingExponent);
+
+    // the bins were laid out for the previous mapping
+    if (m_Feeds && m_Feeds->histogram)
+        m_Feeds->histogram->clear();
+}
+
+void SliderEditPrivate::invalidateText()
+{
+    m_StaticTextValid = false;
+    requestUpdate();
+}
+
+void SliderEditPrivate::requestUpdate()
+{
+    if (m_BatchDepth > 0)
+        m_BatchDirty = true;
+    else
+        m_SliderEdit->update();
+}
+
+bool SliderEditPrivate::isMeter() const
+{
+    return m_Feeds && m_Feeds->valueSource;
+}
+
+void SliderEditPrivate::pollFeeds()
+{
+    // an atomic load, so hidden widgets are kept up to date as well; only visible ones are repainted
+    if (m_Feeds->valueSource)
+    {
+        const qreal value = m_Feeds->valueSource->value();
+        if (value != m_Value && !qIsNaN(value))
+            m_SliderEdit->updateValue(value);
+    }
+
+    // the histogram spans the whole track
+    if (m_Feeds->histogram && m_Feeds->histogram->m_Impl->advance(m_Mapper, m_Min, m_Max) &&
+        m_SliderEdit->isVisible())
+    {
+        if (m_BatchDepth > 0)
+            m_BatchDirty = true;
+        else
+            m_SliderEdit->update(drawRect());
+    }
+}
+
+void SliderEditPrivate::updateFeedSubscription()
+{
+    if (m_Feeds && (m_Feeds->valueSource || m_Feeds->histogram))
+        FrameClock::subscribe(this, [this]() { pollFeeds(); });
+    else
+        FrameClock::unsubscribe(this);
+}
+
+void SliderEditPrivate::drawHistogram(QPainter& painter, const QRect& rect)
+{
+    const SliderHistogramPrivate* histogram = m_Feeds->histogram->m_Impl;
+    if (histogram->m_Peak <= 0.0 || rect.isEmpty())
+        return;
+
+    const qreal pixel_ratio = m_SliderEdit->devicePixelRatioF();
+    const QColor color      = m_SliderEdit->palette().mid().color();
+    const QSize strip_size  = rect.size() * pixel_ratio;
+    if (m_Feeds->strip.size() != strip_size || m_Feeds->stripGeneration != histogram->m_Generation ||
+        m_Feeds->stripColor != color.rgba())
+    {
+        if (m_Feeds->strip.size() != strip_size)
+            m_Feeds->strip = QPixmap(strip_size);
+
+        m_Feeds->strip.setDevicePixelRatio(pixel_ratio);
+        m_Feeds->strip.fill(Qt::transparent);
+
+        // bins run along the track, from the minimum to the maximum
+        QPainter strip_painter(&m_Feeds->strip);
+        const int bins      = histogram->m_Bins.size();
+        const qreal w       = rect.width();
+        const qreal h       = rect.height();
+        const qreal extent  = m_Orientation == Qt::Horizontal ? w : h;
+        const qreal breadth = m_Orientation == Qt::Horizontal ? h : w;
+        for (int i = 0; i < bins; ++i)
+        {
+            const qreal from = extent * i / bins;
+            const qreal to   = extent * (i + 1) / bins;
+            const qreal size = breadth * histogram->m_Bins[i] / histogram->m_Peak;
+            if (m_Orientation == Qt::Horizontal)
+                strip_painter.fillRect(QRectF(from, h - size, to - from, size), color);
+            else
+                strip_painter.fillRect(QRectF(0, h - to, size, to - from), color);
+        }
+
+        m_Feeds->stripGeneration = histogram->m_Generation;
+        m_Feeds->stripColor      = color.rgba();
+    }
+
+    painter.drawPixmap(rect.topLeft(), m_Feeds->strip);
+}
+
+void SliderEditPrivate::updateSeparators()
+{
+    m_Separators    = m_LocalizedNumbers ? NumberFormat::Separators(m_SliderEdit->locale()) : NumberFormat::Separators();
+    m_SizeHintValid = false;
+    invalidateText();
+}
+
+QString SliderEditPrivate::toString(qreal value, bool grouping) const
+{
+    NumberFormat::Separators separators = m_Separators;
+    separators.grouping                 = separators.grouping && grouping;
+    return NumberFormat::toString(value, m_SliderEdit->valueDecimals(), separators);
+}
+
+void SliderEditPrivate::updateDisplayText(const QFont& font, qreal device_pixel_ratio)
+{
+    if (m_StaticTextValid && m_StaticTextValue == m_Value && m_StaticTextFont == font &&
+        qFuzzyCompare(m_StaticTextDevicePixelRatio, device_pixel_ratio))
+    {
+        return;
+    }
+
+    QString label_text;
+    QString text;
+    SliderPainter::displayText(m_Label, toString(m_Value), m_Unit, m_Alignment, &label_text, &text);
+
+    // values closer together than the precision format to the same text, which does not need a new layout
+    const bool relayout = !m_StaticTextValid || m_StaticTextFont != font ||
+                          !qFuzzyCompare(m_StaticTextDevicePixelRatio, device_pixel_ratio) ||
+                          m_LabelStaticText.text() != label_text || m_ValueStaticText.text() != text;
+    if (relayout)
+    {
+        m_LabelStaticText.setText(label_text);
+        m_ValueStaticText.setText(text);
+        m_LabelStaticText.prepare(QTransform(), font);
+        m_ValueStaticText.prepare(QTransform(), font);
+    }
+
+    m_StaticTextFont             = font;
+    m_StaticTextValue            = m_Value;
+    m_StaticTextDevicePixelRatio = device_pixel_ratio;
+    m_StaticTextValid            = true;
+}
+
+void SliderEditPrivate::drawDisplayText(QPainter& painter, const QRect& rect) const
+{
+    if (m_Alignment & Qt::AlignJustify)
+    {
+        if (!m_LabelStaticText.text().isEmpty())
+            painter.drawStaticText(alignedPosition(rect, m_LabelStaticText.size(), Qt::AlignLeft), m_LabelStaticText);
+
+        painter.drawStaticText(alignedPosition(rect, m_ValueStaticText.size(), Qt::AlignRight), m_ValueStaticText);
+    }
+    else
+    {
+        painter.drawStaticText(alignedPosition(rect, m_ValueStaticText.size(), m_Alignment), m_ValueStaticText);
+    }
+}
+
+QRect SliderEditPrivate::displayTextBounds(const QRect& rect) const
+{
+    if (m_Alignment & Qt::AlignJustify)
+    {
+        QRectF bounds(alignedPosition(rect, m_ValueStaticText.size(), Qt::AlignRight), m_ValueStaticText.size());
+        if (!m_LabelStaticText.text().isEmpty())
+            bounds |= QRectF(alignedPosition(rect, m_LabelStaticText.size(), Qt::AlignLeft), m_LabelStaticText.size());
+
+        return bounds.toAlignedRect();
+    }
+
+    const QSizeF size = m_ValueStaticText.size();
+    return QRectF(alignedPosition(rect, size, m_Alignment), size).toAlignedRect();
+}
+
+QRect SliderEditPrivate::drawRect() const
+{
+    return SliderPainter::trackRect(m_SliderEdit->rect());
+}
+
+int SliderEditPrivate::gaugePosition(qreal value, int extent) const
+{
+    // use a clamped value in case SliderBehaviorFlag::AllowValueUnderflow or SliderBehaviorFlag::AllowValueOverflow is
+    // set
+    return m_Mapper.toPosition(qBound(m_Min, value, m_Max), 0, extent);
+}
+
+QRect SliderEditPrivate::gaugeStrip(qreal from, qreal to) const
+{
+    // wide enough to also cover the marker at either end
+    static constexpr const int marker_margin = 3;
+
+    const QRect r = drawRect();
+    if (m_Orientation == Qt::Horizontal)
+    {
+        const int p0 = r.x() + gaugePosition(from, r.width());
+        const int p1 = r.x() + gaugePosition(to, r.width());
+        return QRect(qMin(p0, p1) - marker_margin, r.y(), qAbs(p1 - p0) + marker_margin * 2, r.height());
+    }
+
+    const int p0 = r.y() + r.height() - gaugePosition(from, r.height());
+    const int p1 = r.y() + r.height() - gaugePosition(to, r.height());
+    return QRect(r.x(), qMin(p0, p1) - marker_margin, r.width(), qAbs(p1 - p0) + marker_margin * 2);
+}
+
+void SliderEditPrivate::invalidateValue(qreal old_value)
+{
+    if (old_value == m_Value || !m_SliderEdit->isVisible())
+        return;
+
+    // the whole widget is repainted at the end of the batch
+    if (m_BatchDepth > 0)
+    {
+        m_BatchDirty = true;
+        return;
+    }
+
+    // the edit text does not depend on the value, and repainting it is cheap
+    if (isEditing())
+    {
+        m_SliderEdit->update();
+        return;
+    }
+
+    QRegion dirty;
+    if (m_SliderComponents & (SliderEdit::SliderComponent::Gauge | SliderEdit::SliderComponent::Marker))
+        dirty = gaugeStrip(old_value, m_Value);
+
+    const bool has_text = (m_SliderComponents & SliderEdit::SliderComponent::Text) && m_Orientation == Qt::Horizontal;
+    if (has_text)
+    {
+        // nothing is known about the text on screen until it has been laid out once
+        if (!m_StaticTextValid)
+        {
+            m_SliderEdit->update();
+            return;
+        }
+
+        // the text on screen is the one that was laid out last; lay out the new one to see where it goes
+        const QRect r            = drawRect();
+        const QString label_text = m_LabelStaticText.text();
+        const QString value_text = m_ValueStaticText.text();
+        const QRect old_bounds   = displayTextBounds(r);
+        updateDisplayText(m_SliderEdit->font(), m_SliderEdit->devicePixelRatioF());
+        if (m_LabelStaticText.text() != label_text || m_ValueStaticText.text() != value_text)
+            dirty += old_bounds | displayTextBounds(r);
+    }
+
+    if (!dirty.isEmpty())
+        m_SliderEdit->update(dirty);
 }
 //! @endcond
 
@@ -292,36 +628,42 @@ SliderEdit::~SliderEdit()
 
 QSize SliderEdit::sizeHint() const
 {
-    QFontMetrics fm(font());
+    // layouts query the size hint far more often than the range, precision or font change
+    if (!m_Impl->m_SizeHintValid)
+    {
+        const QFontMetrics fm = StyleResources::fontMetrics(font());
 
-    QString t_min = toString(m_Impl->m_Min, m_Impl->m_Precision);
-    QString t_max = toString(m_Impl->m_Max, m_Impl->m_Precision);
+        QString t_min = m_Impl->toString(m_Impl->m_Min);
+        QString t_max = m_Impl->toString(m_Impl->m_Max);
 
-    int w = qMax(fm.horizontalAdvance(t_min), fm.horizontalAdvance(t_max)) + S_DRAW_PADDING * 2;
-    int h = fm.height() + S_DRAW_PADDING * 2;
+        int w = qMax(fm.horizontalAdvance(t_min), fm.horizontalAdvance(t_max)) + SliderPainter::Padding * 2;
+        int h = fm.height() + SliderPainter::Padding * 2;
 
-    return m_Impl->m_Orientation == Qt::Horizontal ? QSize(w, h) : QSize(h, w);
+        m_Impl->m_SizeHint      = QSize(w, h);
+        m_Impl->m_SizeHintValid = true;
+    }
+
+    const QSize& size = m_Impl->m_SizeHint;
+    return m_Impl->m_Orientation == Qt::Horizontal ? size : size.transposed();
 }
 
 void SliderEdit::updateValue(qreal value)
 {
-    if (m_Impl->m_SliderBehavior & SliderEdit::SliderBehaviorFlag::SnapToPrecision)
-    {
-        value = snapToPrecision(value, m_Impl->m_Precision);
-    }
-
-    value           = qBound(m_Impl->m_Min, value, m_Impl->m_Max);
-    m_Impl->m_Value = value;
+    const qreal old_value = m_Impl->m_Value;
 
-    update();
+    // clamped before it is normalized, so that normalizeValue() can keep it representable within the range
+    const qreal clamped = qBound(m_Impl->m_Min, value, m_Impl->m_Max);
+    m_Impl->m_Value     = qBound(m_Impl->m_Min, normalizeValue(clamped), m_Impl->m_Max);
+    m_Impl->invalidateValue(old_value);
 }
 
 void SliderEdit::setValue(qreal value)
 {
     updateValue(value);
-    Q_EMIT valueChanged(m_Impl->m_Value);
-
-    update();
+    if (m_Impl->m_BatchDepth > 0)
+        m_Impl->m_BatchValueChanged = true;
+    else
+        Q_EMIT valueChanged(m_Impl->m_Value);
 }
 
 qreal SliderEdit::value() const
@@ -336,10 +678,12 @@ void SliderEdit::setMinimum(qreal minimum)
     {
         m_Impl->m_Max = m_Impl->m_Min;
     }
+    m_Impl->m_SizeHintValid = false;
+    m_Impl->updateMapping();
 
     setValue(m_Impl->m_Value);
 
-    update();
+    m_Impl->requestUpdate();
 }
 
 qreal SliderEdit::minimum() const
@@ -354,10 +698,12 @@ void SliderEdit::setMaximum(qreal maximum)
     {
         m_Impl->m_Min = m_Impl->m_Max;
     }
+    m_Impl->m_SizeHintValid = false;
+    m_Impl->updateMapping();
 
     setValue(m_Impl->m_Value);
 
-    update();
+    m_Impl->requestUpdate();
 }
 
 qreal SliderEdit::maximum() const
@@ -367,8 +713,34 @@ qreal SliderEdit::maximum() const
 
 void SliderEdit::setRange(qreal minimum, qreal maximum)
 {
+    beginBatch();
     setMinimum(minimum);
     setMaximum(maximum);
+    endBatch();
+}
+
+void SliderEdit::beginBatch()
+{
+    Q_ASSERT(m_Impl->m_BatchDepth < 255);
+    if (m_Impl->m_BatchDepth++ > 0)
+        return;
+
+    m_Impl->m_BatchStartValue   = m_Impl->m_Value;
+    m_Impl->m_BatchValueChanged = false;
+    m_Impl->m_BatchDirty        = false;
+}
+
+void SliderEdit::endBatch()
+{
+    Q_ASSERT(m_Impl->m_BatchDepth > 0);
+    if (m_Impl->m_BatchDepth == 0 || --m_Impl->m_BatchDepth > 0)
+        return;
+
+    if (m_Impl->m_BatchDirty)
+        update();
+
+    if (m_Impl->m_BatchValueChanged && m_Impl->m_Value != m_Impl->m_BatchStartValue)
+        Q_EMIT valueChanged(m_Impl->m_Value);
 }
 
 bool SliderEdit::editable() const
@@ -384,7 +756,7 @@ void SliderEdit::setEditable(bool editable)
 void SliderEdit::setSingleStep(qreal step)
 {
     m_Impl->m_SingleStep = step;
-    update();
+    m_Impl->requestUpdate();
 }
 
 qreal SliderEdit::singleStep() const
@@ -395,7 +767,7 @@ qreal SliderEdit::singleStep() const
 void SliderEdit::setPageStep(qreal step)
 {
     m_Impl->m_PageStep = step;
-    update();
+    m_Impl->requestUpdate();
 }
 
 qreal SliderEdit::pageStep() const
@@ -405,8 +777,9 @@ qreal SliderEdit::pageStep() const
 
 void SliderEdit::setPrecision(quint32 precision)
 {
-    m_Impl->m_Precision = precision;
-    update();
+    m_Impl->m_Precision     = precision;
+    m_Impl->m_SizeHintValid = false;
+    m_Impl->invalidateText();
 }
 
 quint32 SliderEdit::precision() const
@@ -414,10 +787,24 @@ quint32 SliderEdit::precision() const
     return m_Impl->m_Precision;
 }
 
+void SliderEdit::setLocalizedNumbers(bool localized)
+{
+    if (m_Impl->m_LocalizedNumbers == localized)
+        return;
+
+    m_Impl->m_LocalizedNumbers = localized;
+    m_Impl->updateSeparators();
+}
+
+bool SliderEdit::localizedNumbers() const
+{
+    return m_Impl->m_LocalizedNumbers;
+}
+
 void SliderEdit::setSliderComponents(SliderComponents components)
 {
     m_Impl->m_SliderComponents = components;
-    update();
+    m_Impl->requestUpdate();
 }
 
 SliderEdit::SliderComponents SliderEdit::sliderComponents() const
@@ -436,7 +823,7 @@ void SliderEdit::setSliderBehavior(SliderBehavior behavior)
         setValue(m_Impl->m_Value);
     }
 
-    update();
+    m_Impl->requestUpdate();
 }
 
 SliderEdit::SliderBehavior SliderEdit::sliderBehavior() const
@@ -447,8 +834,9 @@ SliderEdit::SliderBehavior SliderEdit::sliderBehavior() const
 void SliderEdit::setValueMapping(ValueMapping mapping)
 {
     m_Impl->m_ValueMapping = mapping;
+    m_Impl->updateMapping();
 
-    update();
+    m_Impl->requestUpdate();
 }
 
 SliderEdit::ValueMapping SliderEdit::valueMapping() const
@@ -456,10 +844,36 @@ SliderEdit::ValueMapping SliderEdit::valueMapping() const
     return m_Impl->m_ValueMapping;
 }
 
+void SliderEdit::setMappingExponent(qreal exponent)
+{
+    m_Impl->m_MappingExponent = exponent;
+    m_Impl->updateMapping();
+
+    m_Impl->requestUpdate();
+}
+
+qreal SliderEdit::mappingExponent() const
+{
+    return m_Impl->m_MappingExponent;
+}
+
+void SliderEdit::setValueCurve(const QVector<QPointF>& points)
+{
+    // enough samples that linear interpolation between them is indistinguishable from the spline
+    m_Impl->m_Mapper.setCurve(ValueMapper::sampleCurve(points, 256));
+    setValueMapping(CustomScale);
+}
+
+void SliderEdit::setValueCurve(const std::function<qreal(qreal)>& curve, int samples)
+{
+    m_Impl->m_Mapper.setCurve(ValueMapper::sampleCurve(curve, samples));
+    setValueMapping(CustomScale);
+}
+
 void SliderEdit::setAlignment(Qt::Alignment alignment)
 {
     m_Impl->m_Alignment = alignment;
-    update();
+    m_Impl->invalidateText();
 }
 
 Qt::Alignment SliderEdit::alignment() const
@@ -475,7 +889,7 @@ void SliderEdit::setOrientation(Qt::Orientation orientation)
     else
         setSizePolicy(QSizePolicy::Fixed, QSizePolicy::Expanding);
 
-    update();
+    m_Impl->requestUpdate();
 }
 
 Qt::Orientation SliderEdit::orientation() const
@@ -483,10 +897,111 @@ Qt::Orientation SliderEdit::orientation() const
     return m_Impl->m_Orientation;
 }
 
+void SliderEdit::setTrackingPolicy(TrackingPolicy policy)
+{
+    m_Impl->m_Tracker.setPolicy(static_cast<ChangeTracker::Policy>(policy));
+}
+
+SliderEdit::TrackingPolicy SliderEdit::trackingPolicy() const
+{
+    return static_cast<TrackingPolicy>(m_Impl->m_Tracker.policy());
+}
+
+void SliderEdit::setTrackingInterval(int msec)
+{
+    m_Impl->m_Tracker.setInterval(msec);
+}
+
+int SliderEdit::trackingInterval() const
+{
+    return m_Impl->m_Tracker.interval();
+}
+
+void SliderEdit::setValueSource(const QSharedPointer<SliderValueSource>& source)
+{
+    if (!m_Impl->m_Feeds)
+    {
+        if (!source)
+            return;
+
+        m_Impl->m_Feeds = new SliderEditFeeds;
+    }
+
+    m_Impl->m_Feeds->valueSource = source;
+    m_Impl->updateFeedSubscription();
+
+    if (source)
+    {
+        // meters are read-only, so abandon any ongoing interaction
+        if (m_Impl->isEditing())
+            m_Impl->cancelEdit();
+        m_Impl->m_Tracker.finish();
+        m_Impl->m_KeyStepping = false;
+        m_Impl->pollFeeds();
+    }
+}
+
+QSharedPointer<SliderValueSource> SliderEdit::valueSource() const
+{
+    return m_Impl->m_Feeds ? m_Impl->m_Feeds->valueSource : QSharedPointer<SliderValueSource>();
+}
+
+void SliderEdit::setHistogram(const QSharedPointer<SliderHistogram>& histogram)
+{
+    if (!m_Impl->m_Feeds)
+    {
+        if (!histogram)
+            return;
+
+        m_Impl->m_Feeds = new SliderEditFeeds;
+    }
+
+    m_Impl->m_Feeds->histogram = histogram;
+    m_Impl->m_Feeds->strip     = QPixmap();
+    m_Impl->updateFeedSubscription();
+    m_Impl->requestUpdate();
+}
+
+QSharedPointer<SliderHistogram> SliderEdit::histogram() const
+{
+    return m_Impl->m_Feeds ? m_Impl->m_Feeds->histogram : QSharedPointer<SliderHistogram>();
+}
+
+bool SliderEdit::bindProperty(QObject* object, const char* name, PropertyBinding options)
+{
+    unbindProperty();
+
+    SliderPropertyBinding* binding = SliderPropertyBinding::create(this, object, name, options);
+    if (!binding)
+        return false;
+
+    if (!m_Impl->m_Feeds)
+        m_Impl->m_Feeds = new SliderEditFeeds;
+
+    m_Impl->m_Feeds->binding = binding;
+    return true;
+}
+
+void SliderEdit::unbindProperty()
+{
+    if (!m_Impl->m_Feeds)
+        return;
+
+    delete m_Impl->m_Feeds->binding;
+    m_Impl->m_Feeds->binding = nullptr;
+}
+
+QObject* SliderEdit::boundObject() const
+{
+    return m_Impl->m_Feeds && m_Impl->m_Feeds->binding ? m_Impl->m_Feeds->binding->object() : nullptr;
+}
+
 void SliderEdit::setUnit(const QString& unit)
 {
-    m_Impl->m_Unit = unit;
-    update();
+    const QString previous = m_Impl->m_Unit;
+    m_Impl->m_Unit         = acquireString(unit);
+    releaseString(previous);
+    m_Impl->invalidateText();
 }
 
 const QString& SliderEdit::unit() const
@@ -496,8 +1011,10 @@ const QString& SliderEdit::unit() const
 
 void SliderEdit::setLabel(const QString& label)
 {
-    m_Impl->m_Label = label;
-    update();
+    const QString previous = m_Impl->m_Label;
+    m_Impl->m_Label        = acquireString(label);
+    releaseString(previous);
+    m_Impl->invalidateText();
 }
 
 const QString& SliderEdit::label() const
@@ -507,33 +1024,53 @@ const QString& SliderEdit::label() const
 
 void SliderEdit::mousePressEvent(QMouseEvent* event)
 {
+    if (m_Impl->isMeter())
+    {
+        QWidget::mousePressEvent(event);
+        return;
+    }
+
     m_Impl->m_MousePressPos = event->pos();
     if (m_Impl->isEditing())
     {
-        m_Impl->m_EditTextCurPos    = m_Impl->toEditCursorPos(event->pos().x());
-        m_Impl->m_EditTextSelOffset = 0;
+        m_Impl->m_Edit->cursorPos       = m_Impl->toEditCursorPos(event->pos().x());
+        m_Impl->m_Edit->selectionOffset = 0;
     }
 }
 
 void SliderEdit::mouseMoveEvent(QMouseEvent* event)
 {
+    if (m_Impl->isMeter())
+    {
+        QWidget::mouseMoveEvent(event);
+        return;
+    }
+
     if (m_Impl->isEditing())
     {
-        m_Impl->m_AnimEditCursor = false;
-        m_Impl->m_AnimEditCursorActivationTimer.stop();
-        m_Impl->m_EditTextCurPos    = m_Impl->toEditCursorPos(event->pos().x());
-        m_Impl->m_EditTextSelOffset = m_Impl->toEditCursorPos(m_Impl->m_MousePressPos.x()) - m_Impl->m_EditTextCurPos;
+        CursorBlinkClock::hold(this);
+        const quint32 anchor            = m_Impl->toEditCursorPos(m_Impl->m_MousePressPos.x());
+        m_Impl->m_Edit->cursorPos       = m_Impl->toEditCursorPos(event->pos().x());
+        m_Impl->m_Edit->selectionOffset = anchor - m_Impl->m_Edit->cursorPos;
+        update();
     }
     else
     {
-        m_Impl->m_Value = m_Impl->valueFromMousePos(event->pos());
-        Q_EMIT valueChanging(m_Impl->m_Value);
+        const qreal old_value = m_Impl->m_Value;
+        m_Impl->m_Value       = normalizeValue(m_Impl->valueFromMousePos(event->pos()));
+        m_Impl->invalidateValue(old_value);
+        m_Impl->m_Tracker.changing();
     }
-    update();
 }
 
 void SliderEdit::mouseReleaseEvent(QMouseEvent* event)
 {
+    if (m_Impl->isMeter())
+    {
+        QWidget::mouseReleaseEvent(event);
+        return;
+    }
+
     if (!m_Impl->isEditing())
     {
         if (event->pos() == m_Impl->m_MousePressPos)
@@ -543,25 +1080,37 @@ void SliderEdit::mouseReleaseEvent(QMouseEvent* event)
         }
         else
         {
+            m_Impl->m_Tracker.finish();
             setValue(m_Impl->valueFromMousePos(event->pos()));
+            return;
         }
     }
     else
     {
-        m_Impl->m_AnimEditCursorActivationTimer.start(500);
+        CursorBlinkClock::activity(this, S_CURSOR_ACTIVITY_DELAY);
     }
     update();
 }
 
-void SliderEdit::mouseDoubleClickEvent(QMouseEvent*)
+void SliderEdit::mouseDoubleClickEvent(QMouseEvent* event)
 {
+    if (m_Impl->isMeter())
+    {
+        QWidget::mouseDoubleClickEvent(event);
+        return;
+    }
+
     if (!m_Impl->isEditing())
     {
         m_Impl->beginEdit();
     }
 
-    m_Impl->m_EditTextCurPos    = m_Impl->m_EditText.size();
-    m_Impl->m_EditTextSelOffset = -m_Impl->m_EditText.size();
+    // editing may be disabled
+    if (m_Impl->isEditing())
+    {
+        m_Impl->m_Edit->cursorPos       = m_Impl->m_Edit->text.size();
+        m_Impl->m_Edit->selectionOffset = -m_Impl->m_Edit->text.size();
+    }
 }
 
 void SliderEdit::focusInEvent(QFocusEvent* event)
@@ -576,6 +1125,9 @@ void SliderEdit::focusInEvent(QFocusEvent* event)
 
 void SliderEdit::focusOutEvent(QFocusEvent* event)
 {
+    // the key release will not be delivered to this widget
+    m_Impl->finishKeyStepping();
+
     int reason = event->reason();
     switch (reason)
     {
@@ -590,12 +1142,59 @@ void SliderEdit::focusOutEvent(QFocusEvent* event)
     }
 }
 
+qreal SliderEdit::normalizeValue(qreal value) const
+{
+    if (m_Impl->m_SliderBehavior & SliderEdit::SliderBehaviorFlag::SnapToPrecision)
+        value = NumberFormat::snapToPrecision(value, m_Impl->m_Precision);
+
+    return value;
+}
+
+quint32 SliderEdit::valueDecimals() const
+{
+    return m_Impl->m_Precision;
+}
+
+bool SliderEdit::parseValue(const QString& text, qreal* value) const
+{
+    bool valid;
+    *value = m_Impl->m_LocalizedNumbers ? locale().toDouble(text, &valid) : text.toDouble(&valid);
+    return valid;
+}
+
+void SliderEdit::changeEvent(QEvent* event)
+{
+    if (event->type() == QEvent::FontChange)
+    {
+        m_Impl->m_SizeHintValid = false;
+        if (m_Impl->isEditing())
+            m_Impl->m_Edit->setFont(font());
+    }
+    else if (event->type() == QEvent::LocaleChange && m_Impl->m_LocalizedNumbers)
+        m_Impl->updateSeparators();
+    else if (event->type() == QEvent::ActivationChange && m_Impl->isEditing())
+    {
+        // the blink clock stops ticking for inactive windows
+        if (isActiveWindow())
+            CursorBlinkClock::activity(this, S_CURSOR_ACTIVITY_DELAY);
+        else
+            CursorBlinkClock::hold(this);
+    }
+
+    QWidget::changeEvent(event);
+}
+
 void SliderEdit::keyPressEvent(QKeyEvent* event)
 {
+    if (m_Impl->isMeter())
+    {
+        QWidget::keyPressEvent(event);
+        return;
+    }
+
     int key = event->key();
 
-    bool is_input_key = ((key >= Qt::Key_0 && key <= Qt::Key_9) || key == Qt::Key_Comma || key == Qt::Key_Period ||
-                         key == Qt::Key_Backspace || key == Qt::Key_Delete || key == Qt::Key_Minus);
+    bool is_input_key = SliderEditSession::isInputKey(key);
 
     // directly enter edit mode if an input key is pressed
     if (!m_Impl->isEditing() && is_input_key)
@@ -605,6 +1204,8 @@ void SliderEdit::keyPressEvent(QKeyEvent* event)
 
     if (m_Impl->isEditing())
     {
+        CursorBlinkClock::activity(this, S_CURSOR_ACTIVITY_DELAY);
+
         if (key == Qt::Key_Escape)
         {
             m_Impl->cancelEdit();
@@ -613,260 +1214,126 @@ void SliderEdit::keyPressEvent(QKeyEvent* event)
         {
             m_Impl->endEdit();
         }
-        else if (key == Qt::Key_Left)
-        {
-            if (event->modifiers() & Qt::ShiftModifier)
-            {
-                m_Impl->m_EditTextSelOffset += m_Impl->m_EditTextCurPos > 0 ? 1 : 0;
-                m_Impl->m_EditTextCurPos < 1 ? 0 : --m_Impl->m_EditTextCurPos;
-            }
-            else
-            {
-                m_Impl->m_EditTextSelOffset = 0;
-                m_Impl->m_EditTextCurPos < 1 ? 0 : --m_Impl->m_EditTextCurPos;
-            }
-
-            m_Impl->m_AnimEditCursor = false;
-            update();
-            return;
-        }
-        else if (key == Qt::Key_Right)
+        else if (m_Impl->m_Edit->keyPress(event, m_Impl->m_Separators))
         {
-            quint32 eol = m_Impl->m_EditText.size();
-            if (event->modifiers() & Qt::ShiftModifier)
-            {
-                m_Impl->m_EditTextSelOffset -= m_Impl->m_EditTextCurPos < eol ? 1 : 0;
-                m_Impl->m_EditTextCurPos >= eol ? eol : ++m_Impl->m_EditTextCurPos;
-            }
-            else
-            {
-                m_Impl->m_EditTextSelOffset = 0;
-                m_Impl->m_EditTextCurPos >= eol ? eol : ++m_Impl->m_EditTextCurPos;
-            }
-
-            m_Impl->m_AnimEditCursor = false;
             update();
-            return;
-        }
-
-        if (!is_input_key)
-        {
-            return;
-        }
-
-        if (m_Impl->m_EditTextSelOffset)
-        {
-            // delete selection
-            int pos            = qMin(m_Impl->m_EditTextCurPos, m_Impl->m_EditTextCurPos + m_Impl->m_EditTextSelOffset);
-            int n              = qAbs(m_Impl->m_EditTextSelOffset);
-            m_Impl->m_EditText = m_Impl->m_EditText.replace(pos, n, "");
-            m_Impl->m_EditTextCurPos    = pos;
-            m_Impl->m_EditTextSelOffset = 0;
-
-            // insert value of key if a valid input key was pressed
-            if (key != Qt::Key_Delete && key != Qt::Key_Backspace)
-            {
-                m_Impl->m_EditText.insert(m_Impl->m_EditTextCurPos++, event->text()[0]);
-            }
-        }
-        else if (key == Qt::Key_Delete)
-        {
-            m_Impl->m_EditText = m_Impl->m_EditText.replace(m_Impl->m_EditTextCurPos, 1, "");
-        }
-        else if (key == Qt::Key_Backspace)
-        {
-            if (m_Impl->m_EditTextCurPos > 0)
-            {
-                m_Impl->m_EditText = m_Impl->m_EditText.replace(--m_Impl->m_EditTextCurPos, 1, "");
-            }
-        }
-        else
-        {
-            m_Impl->m_EditText.insert(m_Impl->m_EditTextCurPos++, event->text()[0]);
         }
     }
     else
     {
+        qreal step = 0;
         if (key == Qt::Key_Left || key == Qt::Key_Down)
+            step = -m_Impl->m_SingleStep;
+        else if (key == Qt::Key_Right || key == Qt::Key_Up)
+            step = m_Impl->m_SingleStep;
+        else if (key == Qt::Key_PageDown)
+            step = -m_Impl->m_PageStep;
+        else if (key == Qt::Key_PageUp)
+            step = m_Impl->m_PageStep;
+
+        // holding a key down is treated like dragging the slider; valueChanged is emitted when the key is released
+        if (step != 0)
         {
-            setValue(m_Impl->m_Value - m_Impl->m_SingleStep);
+            updateValue(m_Impl->m_Value + step);
+            m_Impl->m_KeyStepping = true;
+            m_Impl->m_Tracker.changing();
         }
+    }
+}
 
-        if (key == Qt::Key_Right || key == Qt::Key_Up)
-        {
-            setValue(m_Impl->m_Value + m_Impl->m_SingleStep);
-        }
+void SliderEdit::keyReleaseEvent(QKeyEvent* event)
+{
+    if (!event->isAutoRepeat() && m_Impl->m_KeyStepping)
+    {
+        m_Impl->finishKeyStepping();
+        return;
+    }
 
-        if (key == Qt::Key_PageDown)
-        {
-            setValue(m_Impl->m_Value - m_Impl->m_PageStep);
-        }
+    QWidget::keyReleaseEvent(event);
+}
 
-        if (key == Qt::Key_PageUp)
-        {
-            setValue(m_Impl->m_Value + m_Impl->m_PageStep);
-        }
-    }
-    update();
+SliderEditStyleOption::SliderEditStyleOption()
+    : value(0.0)
+    , minimum(0.0)
+    , maximum(1.0)
+    , mappingExponent(2.0)
+    , precision(3)
+    , alignment(Qt::AlignCenter)
+    , orientation(Qt::Horizontal)
+    , sliderComponents(SliderEdit::SliderComponent::Text | SliderEdit::SliderComponent::Gauge)
+    , valueMapping(SliderEdit::LinearScale)
+    , localizedNumbers(false)
+{}
+
+void SliderEdit::paint(QPainter* painter, const SliderEditStyleOption& option)
+{
+    painter->save();
+    painter->setRenderHint(QPainter::Antialiasing);
+    SliderPainter::drawSlider(*painter, option, SliderPainter::trackRect(option.rect));
+    painter->restore();
 }
 
-void SliderEdit::paintEvent(QPaintEvent*)
+void SliderEdit::paintEvent(QPaintEvent* event)
 {
-    const QRect& r   = rect().adjusted(S_DRAW_PADDING, S_DRAW_PADDING, -S_DRAW_PADDING, -S_DRAW_PADDING);
+    const QRect& r   = m_Impl->drawRect();
     const QFont& fnt = font();
 
+    // value changes only invalidate the part of the gauge that moved and the text, so stay within that
+    const QRegion clip = event->region() & r;
+    if (clip.isEmpty() && !hasFocus())
+        return;
+
     QPainter painter(this);
     painter.save();
     painter.setRenderHint(QPainter::Antialiasing);
-    painter.setClipRect(r);
+    painter.setClipRegion(clip);
 
     painter.setFont(fnt);
 
-    painter.fillRect(r, palette().base());
+    painter.fillRect(clip.boundingRect(), palette().base());
 
     if (m_Impl->isEditing())
     {
-        QFontMetrics fm(fnt);
-        QRect font_rect        = fm.tightBoundingRect(m_Impl->m_EditText);
-        const int text_offset  = m_Impl->m_Alignment & Qt::AlignRight ? r.width() - font_rect.width() - 1 : 2;
-        const int cursor_width = 1;
-        const QRect text_rect  = r.adjusted(text_offset, 0, 0, 0);
-
-        const int text_cur_pos = S_DRAW_PADDING + text_offset - cursor_width +
-                                 fm.horizontalAdvance(m_Impl->m_EditText.mid(0, m_Impl->m_EditTextCurPos));
-        const int text_sel_pos =
-            S_DRAW_PADDING + text_offset - cursor_width +
-            fm.horizontalAdvance(m_Impl->m_EditText.mid(0, m_Impl->m_EditTextCurPos + m_Impl->m_EditTextSelOffset));
-
-        if (m_Impl->m_EditTextSelOffset != 0)
-        {
-            font_rect.moveLeft(qMin(text_cur_pos, text_sel_pos));
-            font_rect.setRight(qMax(text_cur_pos, text_sel_pos));
-            font_rect.setY(r.y());
-            font_rect.setHeight(r.height());
-            painter.fillRect(font_rect, palette().highlight());
-
-            // paint text inside the highlighted area
-            painter.setClipRect(font_rect);
-            painter.setPen(palette().highlightedText().color());
-            painter.drawText(text_rect, Qt::AlignVCenter | Qt::AlignLeft, m_Impl->m_EditText);
-
-            // paint text outside the highlighted area
-            painter.setClipRegion(QRegion(rect()).subtracted(font_rect));
-            painter.setPen(palette().text().color());
-            painter.drawText(text_rect, Qt::AlignVCenter | Qt::AlignLeft, m_Impl->m_EditText);
-            painter.setClipRect(rect());
-        }
-        else
-        {
-            painter.setPen(palette().text().color());
-            painter.drawText(text_rect, Qt::AlignVCenter | Qt::AlignLeft, m_Impl->m_EditText);
-        }
-
-        if (!m_Impl->m_AnimEditCursor || m_Impl->m_AnimEditCursorVisible)
-        {
-            QLine cursor(qBound(0, text_cur_pos, r.width()), r.y(), text_cur_pos, r.y() + r.height());
-
-            QPen pen(palette().text().color());
-            pen.setWidth(1);
-            painter.setRenderHint(QPainter::Antialiasing, false);
-            painter.setPen(pen);
-            painter.drawLine(cursor);
-            painter.setRenderHint(QPainter::Antialiasing);
-        }
+        SliderPainter::drawEditText(painter,
+                                    palette(),
+                                    clip,
+                                    r,
+                                    *m_Impl->m_Edit,
+                                    m_Impl->editTextOrigin(),
+                                    CursorBlinkClock::cursorVisible(this));
     }
     else
     {
-        int rect_pos;
-        QRect filled_rect;
-        // use a clamped value in case SliderBehaviorFlag::AllowValueUnderflow or SliderBehaviorFlag::AllowValueOverflow
-        // is set
-        const qreal clamped_val = qBound(m_Impl->m_Min, m_Impl->m_Value, m_Impl->m_Max);
-        if (m_Impl->m_Orientation == Qt::Horizontal)
-        {
-            rect_pos = mapToPosition(m_Impl->m_ValueMapping, clamped_val, m_Impl->m_Min, m_Impl->m_Max, 0, r.width());
-            filled_rect = QRect(r.x(), r.y(), rect_pos, r.height());
-        }
-        else
-        {
-            rect_pos = mapToPosition(m_Impl->m_ValueMapping, clamped_val, m_Impl->m_Min, m_Impl->m_Max, 0, r.height());
-            filled_rect = QRect(r.x(), r.y() + r.height() - rect_pos, r.width(), rect_pos);
-        }
+        const int extent   = m_Impl->m_Orientation == Qt::Horizontal ? r.width() : r.height();
+        const int rect_pos = m_Impl->gaugePosition(m_Impl->m_Value, extent);
 
-        if (m_Impl->m_SliderComponents & SliderComponent::Gauge)
-            painter.fillRect(filled_rect, palette().highlight());
+        if (m_Impl->m_Feeds && m_Impl->m_Feeds->histogram)
+            m_Impl->drawHistogram(painter, r);
 
-        auto draw_text = [&]()
-        {
-            bool can_draw_text =
-                (m_Impl->m_SliderComponents & SliderComponent::Text) && m_Impl->m_Orientation == Qt::Horizontal;
-            if (!can_draw_text)
-                return;
-
-            QString text =
-                toString(m_Impl->m_Value, m_Impl->m_Precision) + (m_Impl->m_Unit.isEmpty() ? "" : " " + m_Impl->m_Unit);
-            if (m_Impl->m_Alignment & Qt::AlignJustify)
-            {
-                if (!m_Impl->m_Label.isEmpty())
-                    painter.drawText(r, Qt::AlignLeft, m_Impl->m_Label + ":");
-
-                painter.drawText(r, Qt::AlignRight, text);
-            }
-            else
-            {
-                painter.drawText(
-                    r,
-                    m_Impl->m_Alignment,
-                    QString("%1%2").arg(m_Impl->m_Label.isEmpty() ? "" : m_Impl->m_Label + ": ").arg(text));
-            }
-        };
-
-        if (m_Impl->m_SliderComponents & SliderComponent::Gauge)
+        bool can_draw_text =
+            (m_Impl->m_SliderComponents & SliderComponent::Text) && m_Impl->m_Orientation == Qt::Horizontal;
+        if (can_draw_text)
         {
-            painter.setClipRect(filled_rect);
-            painter.setPen(palette().highlightedText().color());
-            draw_text();
-
-            QRect empty_rect(r.x() + rect_pos, r.y(), r.width() - rect_pos, r.height());
-            painter.setClipRect(empty_rect);
+            m_Impl->updateDisplayText(fnt, devicePixelRatioF());
+            can_draw_text = clip.intersects(m_Impl->displayTextBounds(r));
         }
 
-        painter.setPen(palette().text().color());
-        draw_text();
-        painter.setClipRect(rect());
-
-        if (m_Impl->m_SliderComponents & SliderComponent::Marker)
-        {
-            painter.setRenderHint(QPainter::Antialiasing, false);
-            int marker_pos;
-            QRect marker_rect;
-            if (m_Impl->m_Orientation == Qt::Horizontal)
-            {
-                marker_pos  = qBound(0, r.x() + rect_pos, r.width());
-                marker_rect = QRect(marker_pos - 1, r.y(), 2, r.height() - 1);
-            }
-            else
-            {
-                marker_pos  = qBound(0, r.y() + rect_pos, r.height());
-                marker_rect = QRect(r.x(), r.height() - marker_pos + 1, r.width() - 1, 2);
-            }
-
-            painter.setBrush(Qt::white);
-            painter.setPen(Qt::black);
-            painter.drawRect(marker_rect);
-            painter.setRenderHint(QPainter::Antialiasing);
-        }
+        SliderPainter::drawTrack(painter,
+                                 palette(),
+                                 clip,
+                                 r,
+                                 m_Impl->m_Orientation,
+                                 rect_pos,
+                                 m_Impl->m_SliderComponents,
+                                 [&]()
+                                 {
+                                     if (can_draw_text)
+                                         m_Impl->drawDisplayText(painter, r);
+                                 });
     }
 
     if (hasFocus())
-    {
-        painter.setClipRect(rect(), Qt::NoClip);
-        QStyleOptionFocusRect opts;
-        opts.initFrom(this);
-        opts.rect            = rect().adjusted(1, 1, -1, -1);
-        opts.backgroundColor = palette().window().color();
-        style()->drawPrimitive(QStyle::PE_FrameFocusRect, &opts, &painter, this);
-    }
+        SliderPainter::drawFocusFrame(painter, this, rect());
 
     painter.restore();
 }
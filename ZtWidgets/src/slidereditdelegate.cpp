@@ -0,0 +1,385 @@
+/*
+ * Copyright (c) 2021 Victor Wåhlström
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ * claim that you wrote the original software. If you use this software
+ * in a product, an acknowledgment in the product documentation would be
+ * appreciated but is not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source
+ */
+
+
+#include "editorpool_p.h"
+#include "numberformat_p.h"
+#include "sliderpainter_p.h"
+#include "styleresources_p.h"
+
+#include <ZtWidgets/slidereditdelegate.h>
+
+#include <QApplication>
+#include <QSignalBlocker>
+#include <QStyle>
+
+//! @cond Doxygen_Suppress
+class SliderEditDelegatePrivate
+{
+    Q_DISABLE_COPY(SliderEditDelegatePrivate)
+
+  public:
+    SliderEditDelegatePrivate();
+
+    void range(const QModelIndex& index, qreal* minimum, qreal* maximum) const;
+    QString toString(qreal value, const QLocale& locale) const;
+
+    QString m_Unit;
+    qreal m_Min;
+    qreal m_Max;
+    qreal m_SingleStep;
+    qreal m_PageStep;
+    qreal m_MappingExponent;
+    int m_MinimumRole;
+    int m_MaximumRole;
+    quint32 m_Precision;
+    Qt::Alignment m_Alignment;
+    SliderEdit::SliderComponents m_SliderComponents;
+    SliderEdit::ValueMapping m_ValueMapping;
+    bool m_LocalizedNumbers;
+    EditorPool<SliderEdit> m_Pool;
+};
+
+SliderEditDelegatePrivate::SliderEditDelegatePrivate()
+    : m_Min(0.0)
+    , m_Max(1.0)
+    , m_SingleStep(1.0)
+    , m_PageStep(10.0)
+    , m_MappingExponent(2.0)
+    , m_MinimumRole(-1)
+    , m_MaximumRole(-1)
+    , m_Precision(3)
+    , m_Alignment(Qt::AlignCenter)
+    , m_SliderComponents(SliderEdit::SliderComponent::Text | SliderEdit::SliderComponent::Gauge)
+    , m_ValueMapping(SliderEdit::LinearScale)
+    , m_LocalizedNumbers(false)
+{}
+
+void SliderEditDelegatePrivate::range(const QModelIndex& index, qreal* minimum, qreal* maximum) const
+{
+    *minimum = m_Min;
+    *maximum = m_Max;
+
+    bool ok;
+    if (m_MinimumRole >= 0)
+    {
+        const qreal min = index.data(m_MinimumRole).toDouble(&ok);
+        if (ok)
+            *minimum = min;
+    }
+
+    if (m_MaximumRole >= 0)
+    {
+        const qreal max = index.data(m_MaximumRole).toDouble(&ok);
+        if (ok)
+            *maximum = max;
+    }
+
+    *maximum = qMax(*minimum, *maximum);
+}
+
+QString SliderEditDelegatePrivate::toString(qreal value, const QLocale& locale) const
+{
+    const NumberFormat::Separators separators =
+        m_LocalizedNumbers ? NumberFormat::Separators(locale) : NumberFormat::Separators();
+    return NumberFormat::toString(value, m_Precision, separators);
+}
+//! @endcond
+
+SliderEditDelegate::SliderEditDelegate(QObject* parent)
+    : QStyledItemDelegate(parent)
+    , m_Impl(new SliderEditDelegatePrivate())
+{}
+
+SliderEditDelegate::~SliderEditDelegate()
+{
+    delete m_Impl;
+}
+
+void SliderEditDelegate::setMinimum(qreal minimum)
+{
+    m_Impl->m_Min = minimum;
+    m_Impl->m_Max = qMax(m_Impl->m_Min, m_Impl->m_Max);
+}
+
+qreal SliderEditDelegate::minimum() const
+{
+    return m_Impl->m_Min;
+}
+
+void SliderEditDelegate::setMaximum(qreal maximum)
+{
+    m_Impl->m_Max = maximum;
+    m_Impl->m_Min = qMin(m_Impl->m_Min, m_Impl->m_Max);
+}
+
+qreal SliderEditDelegate::maximum() const
+{
+    return m_Impl->m_Max;
+}
+
+void SliderEditDelegate::setRange(qreal minimum, qreal maximum)
+{
+    m_Impl->m_Min = minimum;
+    m_Impl->m_Max = qMax(minimum, maximum);
+}
+
+void SliderEditDelegate::setRangeRoles(int minimum_role, int maximum_role)
+{
+    m_Impl->m_MinimumRole = minimum_role;
+    m_Impl->m_MaximumRole = maximum_role;
+}
+
+int SliderEditDelegate::minimumRole() const
+{
+    return m_Impl->m_MinimumRole;
+}
+
+int SliderEditDelegate::maximumRole() const
+{
+    return m_Impl->m_MaximumRole;
+}
+
+void SliderEditDelegate::setSingleStep(qreal step)
+{
+    m_Impl->m_SingleStep = step;
+}
+
+qreal SliderEditDelegate::singleStep() const
+{
+    return m_Impl->m_SingleStep;
+}
+
+void SliderEditDelegate::setPageStep(qreal step)
+{
+    m_Impl->m_PageStep = step;
+}
+
+qreal SliderEditDelegate::pageStep() const
+{
+    return m_Impl->m_PageStep;
+}
+
+void SliderEditDelegate::setUnit(const QString& unit)
+{
+    m_Impl->m_Unit = unit;
+}
+
+QString SliderEditDelegate::unit() const
+{
+    return m_Impl->m_Unit;
+}
+
+void SliderEditDelegate::setPrecision(quint32 precision)
+{
+    m_Impl->m_Precision = precision;
+}
+
+quint32 SliderEditDelegate::precision() const
+{
+    return m_Impl->m_Precision;
+}
+
+void SliderEditDelegate::setLocalizedNumbers(bool localized)
+{
+    m_Impl->m_LocalizedNumbers = localized;
+}
+
+bool SliderEditDelegate::localizedNumbers() const
+{
+    return m_Impl->m_LocalizedNumbers;
+}
+
+void SliderEditDelegate::setAlignment(Qt::Alignment alignment)
+{
+    m_Impl->m_Alignment = alignment;
+}
+
+Qt::Alignment SliderEditDelegate::alignment() const
+{
+    return m_Impl->m_Alignment;
+}
+
+void SliderEditDelegate::setSliderComponents(SliderEdit::SliderComponents components)
+{
+    m_Impl->m_SliderComponents = components;
+}
+
+SliderEdit::SliderComponents SliderEditDelegate::sliderComponents() const
+{
+    return m_Impl->m_SliderComponents;
+}
+
+void SliderEditDelegate::setValueMapping(SliderEdit::ValueMapping mapping)
+{
+    m_Impl->m_ValueMapping = mapping == SliderEdit::CustomScale ? SliderEdit::LinearScale : mapping;
+}
+
+SliderEdit::ValueMapping SliderEditDelegate::valueMapping() const
+{
+    return m_Impl->m_ValueMapping;
+}
+
+void SliderEditDelegate::setMappingExponent(qreal exponent)
+{
+    m_Impl->m_MappingExponent = exponent;
+}
+
+qreal SliderEditDelegate::mappingExponent() const
+{
+    return m_Impl->m_MappingExponent;
+}
+
+void SliderEditDelegate::paint(QPainter* painter, const QStyleOptionViewItem& option, const QModelIndex& index) const
+{
+    QStyleOptionViewItem opt = option;
+    initStyleOption(&opt, index);
+
+    // the background, selection and focus of the item, without the text of the display role
+    opt.text.clear();
+    opt.features &= ~QStyleOptionViewItem::HasDisplay;
+    const QWidget* widget = opt.widget;
+    QStyle* style         = widget ? widget->style() : QApplication::style();
+    style->drawControl(QStyle::CE_ItemViewItem, &opt, painter, widget);
+
+    qreal min;
+    qreal max;
+    m_Impl->range(index, &min, &max);
+    const qreal value = qBound(min, index.data(Qt::EditRole).toDouble(), max);
+
+    SliderEditStyleOption slider;
+    slider.rect             = opt.rect;
+    slider.palette          = opt.palette;
+    slider.font             = opt.font;
+    slider.locale           = opt.locale;
+    slider.unit             = m_Impl->m_Unit;
+    slider.value            = value;
+    slider.minimum          = min;
+    slider.maximum          = max;
+    slider.mappingExponent  = m_Impl->m_MappingExponent;
+    slider.precision        = m_Impl->m_Precision;
+    slider.alignment        = m_Impl->m_Alignment;
+    slider.sliderComponents = m_Impl->m_SliderComponents;
+    slider.valueMapping     = m_Impl->m_ValueMapping;
+    slider.localizedNumbers = m_Impl->m_LocalizedNumbers;
+    SliderEdit::paint(painter, slider);
+}
+
+QSize SliderEditDelegate::sizeHint(const QStyleOptionViewItem& option, const QModelIndex& index) const
+{
+    qreal min;
+    qreal max;
+    m_Impl->range(index, &min, &max);
+
+    // the same as the size hint of a SliderEdit with the range of the item
+    const QFontMetrics fm = StyleResources::fontMetrics(option.font);
+    const int w_min       = fm.horizontalAdvance(m_Impl->toString(min, option.locale));
+    const int w_max       = fm.horizontalAdvance(m_Impl->toString(max, option.locale));
+
+    return QSize(qMax(w_min, w_max) + SliderPainter::Padding * 2, fm.height() + SliderPainter::Padding * 2);
+}
+
+void SliderEditDelegate::setEditorPoolSize(int size)
+{
+    m_Impl->m_Pool.setCapacity(size);
+}
+
+int SliderEditDelegate::editorPoolSize() const
+{
+    return m_Impl->m_Pool.capacity();
+}
+
+QWidget* SliderEditDelegate::createEditor(QWidget* parent, const QStyleOptionViewItem&, const QModelIndex&) const
+{
+    SliderEdit* editor = m_Impl->m_Pool.take(parent);
+    if (!editor)
+    {
+        editor = new SliderEdit(parent);
+
+        // commitData is a signal, and createEditor() is const only by the signature of QAbstractItemDelegate
+        SliderEditDelegate* self = const_cast<SliderEditDelegate*>(this);
+        connect(editor, &SliderEdit::valueChanged, self, [self, editor]() { Q_EMIT self->commitData(editor); });
+    }
+
+    // the settings of the delegate may have changed since a pooled editor was last used
+    editor->beginBatch();
+    editor->setSingleStep(m_Impl->m_SingleStep);
+    editor->setPageStep(m_Impl->m_PageStep);
+    editor->setUnit(m_Impl->m_Unit);
+    editor->setPrecision(m_Impl->m_Precision);
+    editor->setLocalizedNumbers(m_Impl->m_LocalizedNumbers);
+    editor->setAlignment(m_Impl->m_Alignment);
+    editor->setSliderComponents(m_Impl->m_SliderComponents);
+    editor->setValueMapping(m_Impl->m_ValueMapping);
+    editor->setMappingExponent(m_Impl->m_MappingExponent);
+    editor->endBatch();
+
+    return editor;
+}
+
+void SliderEditDelegate::destroyEditor(QWidget* editor, const QModelIndex& index) const
+{
+    // the view has already hidden the editor and committed its value
+    SliderEdit* slider_edit = qobject_cast<SliderEdit*>(editor);
+    if (!slider_edit || !m_Impl->m_Pool.give(slider_edit))
+        QStyledItemDelegate::destroyEditor(editor, index);
+}
+
+void SliderEditDelegate::setEditorData(QWidget* editor, const QModelIndex& index) const
+{
+    SliderEdit* slider_edit = qobject_cast<SliderEdit*>(editor);
+    if (!slider_edit)
+    {
+        QStyledItemDelegate::setEditorData(editor, index);
+        return;
+    }
+
+    qreal min;
+    qreal max;
+    m_Impl->range(index, &min, &max);
+
+    // clamping the old value to the new range must not be committed
+    const QSignalBlocker blocker(slider_edit);
+    slider_edit->beginBatch();
+    slider_edit->setRange(min, max);
+    slider_edit->updateValue(index.data(Qt::EditRole).toDouble());
+    slider_edit->endBatch();
+}
+
+void SliderEditDelegate::setModelData(QWidget* editor, QAbstractItemModel* model, const QModelIndex& index) const
+{
+    SliderEdit* slider_edit = qobject_cast<SliderEdit*>(editor);
+    if (!slider_edit)
+    {
+        QStyledItemDelegate::setModelData(editor, model, index);
+        return;
+    }
+
+    model->setData(index, slider_edit->value(), Qt::EditRole);
+}
+
+void SliderEditDelegate::updateEditorGeometry(QWidget* editor,
+                                              const QStyleOptionViewItem& option,
+                                              const QModelIndex&) const
+{
+    editor->setGeometry(option.rect);
+}
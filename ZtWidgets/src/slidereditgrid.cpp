@@ -0,0 +1,396 @@
+/*
+ * Copyright (c) 2021 Victor Wåhlström
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ * claim that you wrote the original software. If you use this software
+ * in a product, an acknowledgment in the product documentation would be
+ * appreciated but is not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source
+ */
+
+
+#include "sliderpainter_p.h"
+#include "sliderrows_p.h"
+
+#include <ZtWidgets/slidereditgrid.h>
+#include <ZtWidgets/slidervaluestore.h>
+
+#include <QPaintEvent>
+#include <QPainter>
+#include <QPointer>
+#include <QScrollBar>
+
+//! @cond Doxygen_Suppress
+class SliderEditGridPrivate : public SliderRowController
+{
+    Q_DISABLE_COPY(SliderEditGridPrivate)
+
+  public:
+    explicit SliderEditGridPrivate(SliderEditGrid*);
+
+    int rowCount() const override { return m_Store ? m_Store->count() : 0; }
+    SliderRow row(int index) const override;
+    QRect rowRect(int index) const override;
+    int rowAt(const QPoint& pos) const override;
+    void emitValueChanged(int index, qreal value) override;
+    void emitValueChanging(int index, qreal value) override;
+    void storeValue(int index, qreal value) override;
+    void scrollTo(int index) override;
+
+    int stride() const { return rowHeight() + Spacing; }
+    void updateScrollBars();
+    void rowsChanged(int first, int last);
+    void countChanged();
+
+    QPointer<SliderValueStore> m_Store;
+    qreal m_SingleStep;
+    qreal m_PageStep;
+
+  private:
+    SliderEditGrid* m_SliderEditGrid;
+};
+
+SliderEditGridPrivate::SliderEditGridPrivate(SliderEditGrid* slider_edit_grid)
+    : SliderRowController(slider_edit_grid->viewport())
+    , m_SingleStep(1.0)
+    , m_PageStep(10.0)
+    , m_SliderEditGrid(slider_edit_grid)
+{}
+
+SliderRow SliderEditGridPrivate::row(int index) const
+{
+    // assembled on demand from the arrays of the store, only for rows which are drawn or interacted with
+    SliderRow row;
+    row.label           = m_Store->label(index);
+    row.value           = m_Store->value(index);
+    row.min             = m_Store->minimum(index);
+    row.max             = m_Store->maximum(index);
+    row.singleStep      = m_SingleStep;
+    row.pageStep        = m_PageStep;
+    row.mappingExponent = m_Store->mappingExponent();
+    row.precision       = m_Store->precision(index);
+    row.valueMapping    = m_Store->valueMapping(index);
+    return row;
+}
+
+QRect SliderEditGridPrivate::rowRect(int index) const
+{
+    const int offset = m_SliderEditGrid->verticalScrollBar()->value();
+    return QRect(0, index * stride() - offset, m_Widget->width(), rowHeight());
+}
+
+int SliderEditGridPrivate::rowAt(const QPoint& pos) const
+{
+    if (!m_Widget->rect().contains(pos))
+        return -1;
+
+    const int y     = pos.y() + m_SliderEditGrid->verticalScrollBar()->value();
+    const int index = y / stride();
+    if (!isValid(index) || y - index * stride() >= rowHeight())
+        return -1;
+
+    return index;
+}
+
+void SliderEditGridPrivate::emitValueChanged(int index, qreal value)
+{
+    Q_EMIT m_SliderEditGrid->valueChanged(index, value);
+}
+
+void SliderEditGridPrivate::emitValueChanging(int index, qreal value)
+{
+    Q_EMIT m_SliderEditGrid->valueChanging(index, value);
+}
+
+void SliderEditGridPrivate::storeValue(int index, qreal value)
+{
+    m_Store->setValue(index, value);
+}
+
+void SliderEditGridPrivate::scrollTo(int index)
+{
+    const QRect r     = rowRect(index);
+    QScrollBar* vsb   = m_SliderEditGrid->verticalScrollBar();
+    const int visible = m_Widget->height();
+
+    if (r.top() < 0)
+        vsb->setValue(vsb->value() + r.top());
+    else if (r.bottom() >= visible)
+        vsb->setValue(vsb->value() + r.bottom() - visible + 1);
+}
+
+void SliderEditGridPrivate::updateScrollBars()
+{
+    const int rows    = rowCount();
+    const int height  = rows * stride() - (rows > 0 ? Spacing : 0);
+    const int visible = m_Widget->height();
+
+    QScrollBar* vsb = m_SliderEditGrid->verticalScrollBar();
+    vsb->setRange(0, qMax(0, height - visible));
+    vsb->setSingleStep(stride());
+    vsb->setPageStep(visible);
+}
+
+void SliderEditGridPrivate::rowsChanged(int first, int last)
+{
+    // only the visible part of the changed rows is repainted, however many rows changed
+    const int offset = m_SliderEditGrid->verticalScrollBar()->value();
+    first            = qMax(first, offset / stride());
+    last             = qMin(last, (offset + m_Widget->height()) / stride());
+    if (first > last)
+        return;
+
+    m_Widget->update(rowRect(first).united(rowRect(last)));
+}
+
+void SliderEditGridPrivate::countChanged()
+{
+    resetInteraction();
+    updateScrollBars();
+    m_Widget->update();
+}
+//! @endcond
+
+SliderEditGrid::SliderEditGrid(QWidget* parent)
+    : QAbstractScrollArea(parent)
+    , m_Impl(new SliderEditGridPrivate(this))
+{
+    setFocusPolicy(Qt::StrongFocus);
+    setHorizontalScrollBarPolicy(Qt::ScrollBarAlwaysOff);
+
+    // the gaps between rows look like the gaps between SliderEdit widgets in a layout
+    viewport()->setBackgroundRole(QPalette::Window);
+}
+
+SliderEditGrid::~SliderEditGrid()
+{
+    delete m_Impl;
+}
+
+void SliderEditGrid::setStore(SliderValueStore* store)
+{
+    if (m_Impl->m_Store == store)
+        return;
+
+    if (m_Impl->m_Store)
+        disconnect(m_Impl->m_Store, nullptr, this, nullptr);
+
+    m_Impl->m_Store = store;
+
+    if (store)
+    {
+        auto on_rows_changed  = [this](int first, int last) { m_Impl->rowsChanged(first, last); };
+        auto on_count_changed = [this]() { m_Impl->countChanged(); };
+        connect(store, &SliderValueStore::rowsChanged, this, on_rows_changed);
+        connect(store, &SliderValueStore::countChanged, this, on_count_changed);
+        connect(store, &QObject::destroyed, this, on_count_changed);
+    }
+
+    verticalScrollBar()->setValue(0);
+    m_Impl->countChanged();
+}
+
+SliderValueStore* SliderEditGrid::store() const
+{
+    return m_Impl->m_Store;
+}
+
+void SliderEditGrid::setCurrentIndex(int index)
+{
+    m_Impl->setCurrentRow(index);
+}
+
+int SliderEditGrid::currentIndex() const
+{
+    return m_Impl->m_CurrentRow;
+}
+
+int SliderEditGrid::indexAt(const QPoint& pos) const
+{
+    return m_Impl->rowAt(pos);
+}
+
+QRect SliderEditGrid::rowRect(int index) const
+{
+    return m_Impl->rowRect(index);
+}
+
+void SliderEditGrid::scrollTo(int index)
+{
+    if (m_Impl->isValid(index))
+        m_Impl->scrollTo(index);
+}
+
+void SliderEditGrid::setSingleStep(qreal step)
+{
+    m_Impl->m_SingleStep = step;
+}
+
+qreal SliderEditGrid::singleStep() const
+{
+    return m_Impl->m_SingleStep;
+}
+
+void SliderEditGrid::setPageStep(qreal step)
+{
+    m_Impl->m_PageStep = step;
+}
+
+qreal SliderEditGrid::pageStep() const
+{
+    return m_Impl->m_PageStep;
+}
+
+void SliderEditGrid::setAlignment(Qt::Alignment alignment)
+{
+    m_Impl->m_Alignment = alignment;
+    viewport()->update();
+}
+
+Qt::Alignment SliderEditGrid::alignment() const
+{
+    return m_Impl->m_Alignment;
+}
+
+void SliderEditGrid::setSliderComponents(SliderEdit::SliderComponents components)
+{
+    m_Impl->m_SliderComponents = components;
+    viewport()->update();
+}
+
+SliderEdit::SliderComponents SliderEditGrid::sliderComponents() const
+{
+    return m_Impl->m_SliderComponents;
+}
+
+void SliderEditGrid::setTrackingPolicy(SliderEdit::TrackingPolicy policy)
+{
+    m_Impl->m_Tracker.setPolicy(static_cast<ChangeTracker::Policy>(policy));
+}
+
+SliderEdit::TrackingPolicy SliderEditGrid::trackingPolicy() const
+{
+    return static_cast<SliderEdit::TrackingPolicy>(m_Impl->m_Tracker.policy());
+}
+
+void SliderEditGrid::setTrackingInterval(int msec)
+{
+    m_Impl->m_Tracker.setInterval(msec);
+}
+
+int SliderEditGrid::trackingInterval() const
+{
+    return m_Impl->m_Tracker.interval();
+}
+
+void SliderEditGrid::paintEvent(QPaintEvent* event)
+{
+    const int rows = m_Impl->rowCount();
+    if (rows == 0)
+        return;
+
+    QPainter painter(viewport());
+    painter.setRenderHint(QPainter::Antialiasing);
+
+    // only the rows within the invalidated area are drawn, which is at most a screenful regardless of the row count
+    const int stride  = m_Impl->stride();
+    const int offset  = verticalScrollBar()->value();
+    const QRect dirty = event->rect();
+    const int first   = qMax(0, (dirty.top() + offset) / stride);
+    const int last    = qMin(rows - 1, (dirty.bottom() + offset) / stride);
+
+    for (int i = first; i <= last; ++i)
+    {
+        const QRect bounds = rowRect(i);
+        const QRect r      = SliderPainter::trackRect(bounds);
+        const QRegion clip = event->region() & r;
+        if (!clip.isEmpty())
+            m_Impl->drawRow(painter, i, bounds, clip);
+
+        if (hasFocus() && i == m_Impl->m_CurrentRow)
+            SliderPainter::drawFocusFrame(painter, this, bounds);
+    }
+}
+
+void SliderEditGrid::resizeEvent(QResizeEvent* event)
+{
+    QAbstractScrollArea::resizeEvent(event);
+    m_Impl->updateScrollBars();
+}
+
+void SliderEditGrid::scrollContentsBy(int, int dy)
+{
+    // rows which stay visible are moved rather than repainted
+    viewport()->scroll(0, dy);
+}
+
+void SliderEditGrid::keyPressEvent(QKeyEvent* event)
+{
+    if (!m_Impl->keyPressEvent(event))
+        QAbstractScrollArea::keyPressEvent(event);
+}
+
+void SliderEditGrid::keyReleaseEvent(QKeyEvent* event)
+{
+    if (!m_Impl->keyReleaseEvent(event))
+        QAbstractScrollArea::keyReleaseEvent(event);
+}
+
+void SliderEditGrid::mousePressEvent(QMouseEvent* event)
+{
+    m_Impl->mousePressEvent(event);
+}
+
+void SliderEditGrid::mouseMoveEvent(QMouseEvent* event)
+{
+    m_Impl->mouseMoveEvent(event);
+}
+
+void SliderEditGrid::mouseReleaseEvent(QMouseEvent* event)
+{
+    m_Impl->mouseReleaseEvent(event);
+}
+
+void SliderEditGrid::mouseDoubleClickEvent(QMouseEvent* event)
+{
+    m_Impl->mouseDoubleClickEvent(event);
+}
+
+void SliderEditGrid::focusInEvent(QFocusEvent* event)
+{
+    m_Impl->focusInEvent(event);
+}
+
+void SliderEditGrid::focusOutEvent(QFocusEvent* event)
+{
+    m_Impl->focusOutEvent(event);
+}
+
+bool SliderEditGrid::focusNextPrevChild(bool next)
+{
+    if (hasFocus() && m_Impl->focusNextPrevChild(next))
+        return true;
+
+    return QAbstractScrollArea::focusNextPrevChild(next);
+}
+
+void SliderEditGrid::changeEvent(QEvent* event)
+{
+    m_Impl->changeEvent(event);
+    if (event->type() == QEvent::FontChange)
+        m_Impl->updateScrollBars();
+
+    QAbstractScrollArea::changeEvent(event);
+}
@@ -0,0 +1,459 @@
+/*
+ * Copyright (c) 2021 Victor Wåhlström
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ * claim that you wrote the original software. If you use this software
+ * in a product, an acknowledgment in the product documentation would be
+ * appreciated but is not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source
+ */
+
+
+#include "sliderpainter_p.h"
+#include "sliderrows_p.h"
+#include "styleresources_p.h"
+
+#include <ZtWidgets/slidereditgroup.h>
+
+#include <QPainter>
+#include <QPaintEvent>
+#include <QVector>
+
+//! @cond Doxygen_Suppress
+class SliderEditGroupPrivate : public SliderRowController
+{
+    Q_DISABLE_COPY(SliderEditGroupPrivate)
+
+  public:
+    explicit SliderEditGroupPrivate(SliderEditGroup*);
+
+    int rowCount() const override { return m_Rows.size(); }
+    SliderRow row(int index) const override { return m_Rows[index]; }
+    QRect rowRect(int index) const override;
+    int rowAt(const QPoint& pos) const override;
+    void emitValueChanged(int index, qreal value) override;
+    void emitValueChanging(int index, qreal value) override;
+    void storeValue(int index, qreal value) override;
+
+    // the rows, stored as plain data
+    QVector<SliderRow> m_Rows;
+    QSize m_SizeHint;
+    bool m_SizeHintValid;
+
+  private:
+    SliderEditGroup* m_SliderEditGroup;
+};
+
+SliderEditGroupPrivate::SliderEditGroupPrivate(SliderEditGroup* slider_edit_group)
+    : SliderRowController(slider_edit_group)
+    , m_SizeHintValid(false)
+    , m_SliderEditGroup(slider_edit_group)
+{}
+
+QRect SliderEditGroupPrivate::rowRect(int index) const
+{
+    const int height = rowHeight();
+    return QRect(0, index * (height + Spacing), m_SliderEditGroup->width(), height);
+}
+
+int SliderEditGroupPrivate::rowAt(const QPoint& pos) const
+{
+    if (!m_SliderEditGroup->rect().contains(pos))
+        return -1;
+
+    const int height = rowHeight();
+    const int index  = pos.y() / (height + Spacing);
+    if (!isValid(index) || pos.y() - index * (height + Spacing) >= height)
+        return -1;
+
+    return index;
+}
+
+void SliderEditGroupPrivate::emitValueChanged(int index, qreal value)
+{
+    Q_EMIT m_SliderEditGroup->valueChanged(index, value);
+}
+
+void SliderEditGroupPrivate::emitValueChanging(int index, qreal value)
+{
+    Q_EMIT m_SliderEditGroup->valueChanging(index, value);
+}
+
+void SliderEditGroupPrivate::storeValue(int index, qreal value)
+{
+    m_Rows[index].value = value;
+}
+//! @endcond
+
+SliderEditGroup::SliderEditGroup(QWidget* parent)
+    : QWidget(parent)
+    , m_Impl(new SliderEditGroupPrivate(this))
+{
+    setFocusPolicy(Qt::StrongFocus);
+}
+
+SliderEditGroup::~SliderEditGroup()
+{
+    delete m_Impl;
+}
+
+int SliderEditGroup::addRow(const QString& label, qreal minimum, qreal maximum)
+{
+    SliderRow row;
+    row.label           = label;
+    row.min             = minimum;
+    row.max             = qMax(minimum, maximum);
+    row.value           = row.min;
+    row.singleStep      = 1.0;
+    row.pageStep        = 10.0;
+    row.mappingExponent = 2.0;
+    row.precision       = 3;
+    row.valueMapping    = SliderEdit::LinearScale;
+    m_Impl->m_Rows.append(row);
+
+    if (m_Impl->m_CurrentRow < 0)
+        m_Impl->m_CurrentRow = 0;
+
+    m_Impl->m_SizeHintValid = false;
+    updateGeometry();
+    update();
+    return m_Impl->m_Rows.size() - 1;
+}
+
+void SliderEditGroup::removeRow(int index)
+{
+    if (!m_Impl->isValid(index))
+        return;
+
+    m_Impl->m_Rows.remove(index);
+    m_Impl->resetInteraction();
+
+    m_Impl->m_SizeHintValid = false;
+    updateGeometry();
+    update();
+}
+
+void SliderEditGroup::clear()
+{
+    m_Impl->m_Rows.clear();
+    m_Impl->resetInteraction();
+
+    m_Impl->m_SizeHintValid = false;
+    updateGeometry();
+    update();
+}
+
+int SliderEditGroup::count() const
+{
+    return m_Impl->m_Rows.size();
+}
+
+void SliderEditGroup::updateValue(int index, qreal value)
+{
+    if (m_Impl->isValid(index))
+        m_Impl->changeValue(index, value);
+}
+
+void SliderEditGroup::setValue(int index, qreal value)
+{
+    if (m_Impl->isValid(index) && m_Impl->changeValue(index, value))
+        Q_EMIT valueChanged(index, m_Impl->m_Rows[index].value);
+}
+
+qreal SliderEditGroup::value(int index) const
+{
+    return m_Impl->isValid(index) ? m_Impl->m_Rows[index].value : 0.0;
+}
+
+void SliderEditGroup::setRange(int index, qreal minimum, qreal maximum)
+{
+    if (!m_Impl->isValid(index))
+        return;
+
+    SliderRow& row          = m_Impl->m_Rows[index];
+    row.min                 = minimum;
+    row.max                 = qMax(minimum, maximum);
+    m_Impl->m_SizeHintValid = false;
+    updateGeometry();
+
+    setValue(index, row.value);
+    m_Impl->updateRow(index);
+}
+
+qreal SliderEditGroup::minimum(int index) const
+{
+    return m_Impl->isValid(index) ? m_Impl->m_Rows[index].min : 0.0;
+}
+
+qreal SliderEditGroup::maximum(int index) const
+{
+    return m_Impl->isValid(index) ? m_Impl->m_Rows[index].max : 0.0;
+}
+
+void SliderEditGroup::setLabel(int index, const QString& label)
+{
+    if (!m_Impl->isValid(index))
+        return;
+
+    m_Impl->m_Rows[index].label = label;
+    m_Impl->updateRow(index);
+}
+
+QString SliderEditGroup::label(int index) const
+{
+    return m_Impl->isValid(index) ? m_Impl->m_Rows[index].label : QString();
+}
+
+void SliderEditGroup::setUnit(int index, const QString& unit)
+{
+    if (!m_Impl->isValid(index))
+        return;
+
+    m_Impl->m_Rows[index].unit = unit;
+    m_Impl->updateRow(index);
+}
+
+QString SliderEditGroup::unit(int index) const
+{
+    return m_Impl->isValid(index) ? m_Impl->m_Rows[index].unit : QString();
+}
+
+void SliderEditGroup::setPrecision(int index, quint32 precision)
+{
+    if (!m_Impl->isValid(index))
+        return;
+
+    m_Impl->m_Rows[index].precision = precision;
+    m_Impl->m_SizeHintValid         = false;
+    updateGeometry();
+    m_Impl->updateRow(index);
+}
+
+quint32 SliderEditGroup::precision(int index) const
+{
+    return m_Impl->isValid(index) ? m_Impl->m_Rows[index].precision : 0;
+}
+
+void SliderEditGroup::setSteps(int index, qreal single_step, qreal page_step)
+{
+    if (!m_Impl->isValid(index))
+        return;
+
+    m_Impl->m_Rows[index].singleStep = single_step;
+    m_Impl->m_Rows[index].pageStep   = page_step;
+}
+
+qreal SliderEditGroup::singleStep(int index) const
+{
+    return m_Impl->isValid(index) ? m_Impl->m_Rows[index].singleStep : 0.0;
+}
+
+qreal SliderEditGroup::pageStep(int index) const
+{
+    return m_Impl->isValid(index) ? m_Impl->m_Rows[index].pageStep : 0.0;
+}
+
+void SliderEditGroup::setValueMapping(int index, SliderEdit::ValueMapping mapping, qreal exponent)
+{
+    if (!m_Impl->isValid(index))
+        return;
+
+    m_Impl->m_Rows[index].valueMapping    = mapping;
+    m_Impl->m_Rows[index].mappingExponent = exponent;
+    m_Impl->updateRow(index);
+}
+
+SliderEdit::ValueMapping SliderEditGroup::valueMapping(int index) const
+{
+    return m_Impl->isValid(index) ? m_Impl->m_Rows[index].valueMapping : SliderEdit::LinearScale;
+}
+
+qreal SliderEditGroup::mappingExponent(int index) const
+{
+    return m_Impl->isValid(index) ? m_Impl->m_Rows[index].mappingExponent : 0.0;
+}
+
+void SliderEditGroup::setCurrentIndex(int index)
+{
+    m_Impl->setCurrentRow(index);
+}
+
+int SliderEditGroup::currentIndex() const
+{
+    return m_Impl->m_CurrentRow;
+}
+
+int SliderEditGroup::indexAt(const QPoint& pos) const
+{
+    return m_Impl->rowAt(pos);
+}
+
+QRect SliderEditGroup::rowRect(int index) const
+{
+    return m_Impl->rowRect(index);
+}
+
+void SliderEditGroup::setAlignment(Qt::Alignment alignment)
+{
+    m_Impl->m_Alignment = alignment;
+    update();
+}
+
+Qt::Alignment SliderEditGroup::alignment() const
+{
+    return m_Impl->m_Alignment;
+}
+
+void SliderEditGroup::setSliderComponents(SliderEdit::SliderComponents components)
+{
+    m_Impl->m_SliderComponents = components;
+    update();
+}
+
+SliderEdit::SliderComponents SliderEditGroup::sliderComponents() const
+{
+    return m_Impl->m_SliderComponents;
+}
+
+void SliderEditGroup::setTrackingPolicy(SliderEdit::TrackingPolicy policy)
+{
+    m_Impl->m_Tracker.setPolicy(static_cast<ChangeTracker::Policy>(policy));
+}
+
+SliderEdit::TrackingPolicy SliderEditGroup::trackingPolicy() const
+{
+    return static_cast<SliderEdit::TrackingPolicy>(m_Impl->m_Tracker.policy());
+}
+
+void SliderEditGroup::setTrackingInterval(int msec)
+{
+    m_Impl->m_Tracker.setInterval(msec);
+}
+
+int SliderEditGroup::trackingInterval() const
+{
+    return m_Impl->m_Tracker.interval();
+}
+
+QSize SliderEditGroup::sizeHint() const
+{
+    if (!m_Impl->m_SizeHintValid)
+    {
+        const QFontMetrics fm = StyleResources::fontMetrics(font());
+
+        int w = 0;
+        for (const SliderRow& row : m_Impl->m_Rows)
+        {
+            w = qMax(w, fm.horizontalAdvance(m_Impl->toString(row, row.min)));
+            w = qMax(w, fm.horizontalAdvance(m_Impl->toString(row, row.max)));
+        }
+
+        const int rows          = m_Impl->m_Rows.size();
+        const int h             = rows * m_Impl->rowHeight() + qMax(0, rows - 1) * SliderRowController::Spacing;
+        m_Impl->m_SizeHint      = QSize(w + SliderPainter::Padding * 2, h);
+        m_Impl->m_SizeHintValid = true;
+    }
+
+    return m_Impl->m_SizeHint;
+}
+
+void SliderEditGroup::paintEvent(QPaintEvent* event)
+{
+    if (m_Impl->m_Rows.isEmpty())
+        return;
+
+    QPainter painter(this);
+    painter.setRenderHint(QPainter::Antialiasing);
+
+    // only the rows within the invalidated area are drawn
+    const int stride  = m_Impl->rowHeight() + SliderRowController::Spacing;
+    const QRect dirty = event->rect();
+    const int first   = qMax(0, dirty.top() / stride);
+    const int last    = qMin(m_Impl->m_Rows.size() - 1, dirty.bottom() / stride);
+
+    for (int i = first; i <= last; ++i)
+    {
+        const QRect bounds = rowRect(i);
+        const QRect r      = SliderPainter::trackRect(bounds);
+        const QRegion clip = event->region() & r;
+        if (!clip.isEmpty())
+            m_Impl->drawRow(painter, i, bounds, clip);
+
+        if (hasFocus() && i == m_Impl->m_CurrentRow)
+            SliderPainter::drawFocusFrame(painter, this, bounds);
+    }
+}
+
+void SliderEditGroup::keyPressEvent(QKeyEvent* event)
+{
+    if (!m_Impl->keyPressEvent(event))
+        QWidget::keyPressEvent(event);
+}
+
+void SliderEditGroup::keyReleaseEvent(QKeyEvent* event)
+{
+    if (!m_Impl->keyReleaseEvent(event))
+        QWidget::keyReleaseEvent(event);
+}
+
+void SliderEditGroup::mousePressEvent(QMouseEvent* event)
+{
+    m_Impl->mousePressEvent(event);
+}
+
+void SliderEditGroup::mouseMoveEvent(QMouseEvent* event)
+{
+    m_Impl->mouseMoveEvent(event);
+}
+
+void SliderEditGroup::mouseReleaseEvent(QMouseEvent* event)
+{
+    m_Impl->mouseReleaseEvent(event);
+}
+
+void SliderEditGroup::mouseDoubleClickEvent(QMouseEvent* event)
+{
+    m_Impl->mouseDoubleClickEvent(event);
+}
+
+void SliderEditGroup::focusInEvent(QFocusEvent* event)
+{
+    m_Impl->focusInEvent(event);
+}
+
+void SliderEditGroup::focusOutEvent(QFocusEvent* event)
+{
+    m_Impl->focusOutEvent(event);
+}
+
+bool SliderEditGroup::focusNextPrevChild(bool next)
+{
+    if (hasFocus() && m_Impl->focusNextPrevChild(next))
+        return true;
+
+    return QWidget::focusNextPrevChild(next);
+}
+
+void SliderEditGroup::changeEvent(QEvent* event)
+{
+    if (event->type() == QEvent::FontChange)
+    {
+        m_Impl->m_SizeHintValid = false;
+        updateGeometry();
+    }
+
+    m_Impl->changeEvent(event);
+    QWidget::changeEvent(event);
+}
@@ -0,0 +1,179 @@
+/*
+ * Copyright (c) 2021 Victor Wåhlström
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ * claim that you wrote the original software. If you use this software
+ * in a product, an acknowledgment in the product documentation would be
+ * appreciated but is not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source
+ */
+
+
+#include "slidereditsession_p.h"
+
+#include <QKeyEvent>
+
+#include <algorithm>
+
+SliderEditSession::SliderEditSession(const QFont& edit_font, const QString& edit_text)
+    : text(edit_text)
+    , originalText(edit_text)
+    , metrics(edit_font)
+    , cursorPos(edit_text.size())
+    , selectionOffset(-edit_text.size())
+{
+    setFont(edit_font);
+}
+
+bool SliderEditSession::isInputKey(int key)
+{
+    return (key >= Qt::Key_0 && key <= Qt::Key_9) || key == Qt::Key_Comma || key == Qt::Key_Period ||
+           key == Qt::Key_Backspace || key == Qt::Key_Delete || key == Qt::Key_Minus;
+}
+
+QChar SliderEditSession::inputCharacter(const QKeyEvent* event, const NumberFormat::Separators& separators)
+{
+    // either key inserts the decimal point of the locale, as keypads often only have one of them
+    switch (event->key())
+    {
+        case Qt::Key_Comma:
+        case Qt::Key_Period:
+            return separators.decimalPoint;
+        case Qt::Key_Minus:
+            return separators.negativeSign;
+        default:
+            return event->text()[0];
+    }
+}
+
+void SliderEditSession::setFont(const QFont& edit_font)
+{
+    font = edit_font;
+    font.setKerning(false);
+    metrics = QFontMetricsF(font);
+
+    advances.resize(text.size() + 1);
+    advances[0] = 0;
+    for (int i = 0; i < text.size(); ++i)
+        advances[i + 1] = advances[i] + metrics.horizontalAdvance(text[i]);
+}
+
+void SliderEditSession::insert(int pos, QChar c)
+{
+    const qreal w = metrics.horizontalAdvance(c);
+    text.insert(pos, c);
+    advances.insert(pos + 1, advances[pos] + w);
+    for (int i = pos + 2; i < advances.size(); ++i)
+        advances[i] += w;
+}
+
+void SliderEditSession::remove(int pos, int n)
+{
+    n = qMin(n, text.size() - pos);
+    if (n <= 0)
+        return;
+
+    const qreal w = advances[pos + n] - advances[pos];
+    text.remove(pos, n);
+    advances.remove(pos + 1, n);
+    for (int i = pos + 1; i < advances.size(); ++i)
+        advances[i] -= w;
+}
+
+int SliderEditSession::cursorAt(qreal x) const
+{
+    // the character boundary closest to x
+    auto it = std::lower_bound(advances.constBegin(), advances.constEnd(), x);
+    if (it == advances.constBegin())
+        return 0;
+    if (it == advances.constEnd())
+        return text.size();
+
+    const int i = it - advances.constBegin();
+    return x - advances[i - 1] < advances[i] - x ? i - 1 : i;
+}
+
+bool SliderEditSession::keyPress(const QKeyEvent* event, const NumberFormat::Separators& separators)
+{
+    const int key = event->key();
+    if (key == Qt::Key_Left)
+    {
+        if (event->modifiers() & Qt::ShiftModifier)
+        {
+            selectionOffset += cursorPos > 0 ? 1 : 0;
+            cursorPos < 1 ? 0 : --cursorPos;
+        }
+        else
+        {
+            selectionOffset = 0;
+            cursorPos < 1 ? 0 : --cursorPos;
+        }
+
+        return true;
+    }
+
+    if (key == Qt::Key_Right)
+    {
+        quint32 eol = text.size();
+        if (event->modifiers() & Qt::ShiftModifier)
+        {
+            selectionOffset -= cursorPos < eol ? 1 : 0;
+            cursorPos >= eol ? eol : ++cursorPos;
+        }
+        else
+        {
+            selectionOffset = 0;
+            cursorPos >= eol ? eol : ++cursorPos;
+        }
+
+        return true;
+    }
+
+    if (!isInputKey(key))
+        return false;
+
+    if (selectionOffset)
+    {
+        // delete selection
+        int pos = qMin(cursorPos, cursorPos + selectionOffset);
+        int n   = qAbs(selectionOffset);
+        remove(pos, n);
+        cursorPos       = pos;
+        selectionOffset = 0;
+
+        // insert value of key if a valid input key was pressed
+        if (key != Qt::Key_Delete && key != Qt::Key_Backspace)
+        {
+            insert(cursorPos++, inputCharacter(event, separators));
+        }
+    }
+    else if (key == Qt::Key_Delete)
+    {
+        remove(cursorPos, 1);
+    }
+    else if (key == Qt::Key_Backspace)
+    {
+        if (cursorPos > 0)
+        {
+            remove(--cursorPos, 1);
+        }
+    }
+    else
+    {
+        insert(cursorPos++, inputCharacter(event, separators));
+    }
+
+    return true;
+}
@@ -0,0 +1,66 @@
+/*
+ * Copyright (c) 2021 Victor Wåhlström
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ * claim that you wrote the original software. If you use this software
+ * in a product, an acknowledgment in the product documentation would be
+ * appreciated but is not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source
+ */
+
+
+#ifndef SLIDEREDITSESSION_H
+#define SLIDEREDITSESSION_H
+
+#include "numberformat_p.h"
+
+#include <QFont>
+#include <QFontMetricsF>
+#include <QString>
+#include <QVector>
+
+class QKeyEvent;
+
+//! @cond Doxygen_Suppress
+// state which only exists while a value is edited as text; most sliders are never edited
+struct SliderEditSession
+{
+    SliderEditSession(const QFont& font, const QString& text);
+
+    static bool isInputKey(int key);
+    static QChar inputCharacter(const QKeyEvent* event, const NumberFormat::Separators& separators);
+
+    void setFont(const QFont& font);
+    void insert(int pos, QChar c);
+    void remove(int pos, int n);
+    int cursorAt(qreal x) const;
+    qreal width() const { return advances.last(); }
+
+    // moves the cursor or edits the text. Returns false if the key is not an editing key.
+    bool keyPress(const QKeyEvent* event, const NumberFormat::Separators& separators);
+
+    QString text;
+    QString originalText;
+    // advances[i] is the width of the first i characters. Kerning is disabled in font, so the advances of single
+    // characters add up to exactly the width of the text as drawn, and can be updated one character at a time.
+    QVector<qreal> advances;
+    QFont font;
+    QFontMetricsF metrics;
+    quint32 cursorPos;
+    qint32 selectionOffset;
+};
+//! @endcond
+
+#endif // SLIDEREDITSESSION_H
@@ -0,0 +1,182 @@
+/*
+ * Copyright (c) 2021 Victor Wåhlström
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ * claim that you wrote the original software. If you use this software
+ * in a product, an acknowledgment in the product documentation would be
+ * appreciated but is not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source
+ */
+
+
+#include "sliderhistogram_p.h"
+
+#include "frameclock_p.h"
+#include "valuemapping_p.h"
+
+#include <ZtWidgets/sliderhistogram.h>
+
+#include <QtMath>
+
+// below this, a faded histogram is indistinguishable from an empty one
+static constexpr const qreal S_MIN_PEAK = 1e-2;
+
+//! @cond Doxygen_Suppress
+// bins pending samples, instantiated for each value mapping policy
+struct BinSamples
+{
+    SliderHistogramPrivate* histogram;
+    quint32 tail;
+    quint32 head;
+    qreal min;
+    qreal max;
+    bool binned;
+
+    template<typename Policy>
+    void apply(const ValueMappingCoefficients& k)
+    {
+        const int bins = histogram->m_Bins.size();
+        qreal* data    = histogram->m_Bins.data();
+        qreal peak     = histogram->m_Peak;
+        for (quint32 i = tail; i != head; ++i)
+        {
+            // also rejects NaN
+            const qreal value = histogram->m_Samples[i & histogram->m_Mask];
+            if (!(value >= min && value <= max))
+                continue;
+
+            const int bin = qBound(0, static_cast<int>(Policy::toUnit(k, value) * bins), bins - 1);
+            data[bin] += 1.0;
+            peak   = qMax(peak, data[bin]);
+            binned = true;
+        }
+
+        histogram->m_Peak = peak;
+    }
+};
+//! @endcond
+
+SliderHistogramPrivate::SliderHistogramPrivate(int bins, int capacity)
+    : m_Bins(qMax(bins, 1), 0.0)
+    , m_Samples(nullptr)
+    , m_Head(0)
+    , m_Tail(0)
+    , m_Mask(qNextPowerOfTwo(static_cast<quint32>(qMax(capacity, 2) - 1)) - 1)
+    , m_Peak(0.0)
+    , m_DecayFactor(1.0)
+    , m_Generation(0)
+    , m_AdvancedGeneration(0)
+    , m_HalfLife(0)
+{
+    m_Samples = new qreal[m_Mask + 1];
+}
+
+SliderHistogramPrivate::~SliderHistogramPrivate()
+{
+    delete[] m_Samples;
+}
+
+bool SliderHistogramPrivate::advance(const ValueMapper& mapper, qreal min, qreal max)
+{
+    bool changed = false;
+
+    // every bin decays by the same factor, so the peak stays exact. The histogram is drawn relative to its peak, so a
+    // decay alone looks the same until the histogram fades out entirely.
+    if (m_DecayFactor < 1.0 && m_Peak > 0.0)
+    {
+        m_Peak *= m_DecayFactor;
+        if (m_Peak < S_MIN_PEAK)
+        {
+            m_Bins.fill(0.0);
+            m_Peak  = 0.0;
+            changed = true;
+        }
+        else
+        {
+            for (qreal& bin : m_Bins)
+                bin *= m_DecayFactor;
+        }
+    }
+
+    const quint32 tail = m_Tail.loadRelaxed();
+    const quint32 head = m_Head.loadAcquire();
+    if (head != tail)
+    {
+        // the mapping is selected once for the whole batch
+        BinSamples binner = {this, tail, head, min, max, false};
+        mapper.dispatch(binner);
+        changed = changed || binner.binned;
+
+        m_Tail.storeRelease(head);
+    }
+
+    if (changed)
+        ++m_Generation;
+
+    // also reports a clear() since the last frame
+    changed              = m_Generation != m_AdvancedGeneration;
+    m_AdvancedGeneration = m_Generation;
+    return changed;
+}
+
+void SliderHistogramPrivate::clear()
+{
+    m_Bins.fill(0.0);
+    m_Peak = 0.0;
+    ++m_Generation;
+}
+
+SliderHistogram::SliderHistogram(int bins, int capacity)
+    : m_Impl(new SliderHistogramPrivate(bins, capacity))
+{
+    setHalfLife(1000);
+}
+
+SliderHistogram::~SliderHistogram()
+{
+    delete m_Impl;
+}
+
+bool SliderHistogram::addSample(qreal value)
+{
+    const quint32 head = m_Impl->m_Head.loadRelaxed();
+    if (head - m_Impl->m_Tail.loadAcquire() > m_Impl->m_Mask)
+        return false;
+
+    m_Impl->m_Samples[head & m_Impl->m_Mask] = value;
+    m_Impl->m_Head.storeRelease(head + 1);
+    return true;
+}
+
+void SliderHistogram::setHalfLife(int msec)
+{
+    m_Impl->m_HalfLife    = qMax(0, msec);
+    m_Impl->m_DecayFactor = m_Impl->m_HalfLife > 0 ? qPow(0.5, qreal(FrameClock::Interval) / m_Impl->m_HalfLife) : 1.0;
+}
+
+int SliderHistogram::halfLife() const
+{
+    return m_Impl->m_HalfLife;
+}
+
+int SliderHistogram::binCount() const
+{
+    return m_Impl->m_Bins.size();
+}
+
+void SliderHistogram::clear()
+{
+    m_Impl->clear();
+}
@@ -0,0 +1,63 @@
+/*
+ * Copyright (c) 2021 Victor Wåhlström
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ * claim that you wrote the original software. If you use this software
+ * in a product, an acknowledgment in the product documentation would be
+ * appreciated but is not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source
+ */
+
+
+#ifndef SLIDERHISTOGRAM_P_H
+#define SLIDERHISTOGRAM_P_H
+
+#include <QAtomicInteger>
+#include <QVector>
+
+class ValueMapper;
+
+//! @cond Doxygen_Suppress
+class SliderHistogramPrivate
+{
+    Q_DISABLE_COPY(SliderHistogramPrivate)
+
+  public:
+    SliderHistogramPrivate(int bins, int capacity);
+    ~SliderHistogramPrivate();
+
+    /**
+     * @brief Apply one frame of decay and bin all pending samples
+     * @return true if the histogram looks different since the last frame
+     */
+    bool advance(const ValueMapper& mapper, qreal min, qreal max);
+
+    void clear();
+
+    QVector<qreal> m_Bins;
+    // single producer, single consumer ring buffer. The indices grow indefinitely and are masked on access.
+    qreal* m_Samples;
+    QAtomicInteger<quint32> m_Head;
+    QAtomicInteger<quint32> m_Tail;
+    quint32 m_Mask;
+    qreal m_Peak;
+    qreal m_DecayFactor;
+    quint32 m_Generation;
+    quint32 m_AdvancedGeneration;
+    int m_HalfLife;
+};
+//! @endcond
+
+#endif // SLIDERHISTOGRAM_P_H
@@ -0,0 +1,212 @@
+/*
+ * Copyright (c) 2021 Victor Wåhlström
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ * claim that you wrote the original software. If you use this software
+ * in a product, an acknowledgment in the product documentation would be
+ * appreciated but is not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source
+ */
+
+
+#include "sliderpainter_p.h"
+
+#include "numberformat_p.h"
+#include "slidereditsession_p.h"
+#include "valuemapping_p.h"
+
+#include <QStyle>
+#include <QStyleOption>
+#include <QWidget>
+
+QRect SliderPainter::gaugeRect(const QRect& track, Qt::Orientation orientation, int position)
+{
+    if (orientation == Qt::Horizontal)
+        return QRect(track.x(), track.y(), position, track.height());
+
+    return QRect(track.x(), track.y() + track.height() - position, track.width(), position);
+}
+
+void SliderPainter::displayText(const QString& label,
+                                const QString& value,
+                                const QString& unit,
+                                Qt::Alignment alignment,
+                                QString* label_text,
+                                QString* value_text)
+{
+    QString text = value;
+    if (!unit.isEmpty())
+        text += QLatin1Char(' ') + unit;
+
+    label_text->clear();
+    if (alignment & Qt::AlignJustify)
+    {
+        if (!label.isEmpty())
+            *label_text = label + QLatin1Char(':');
+    }
+    else if (!label.isEmpty())
+    {
+        text = label + QStringLiteral(": ") + text;
+    }
+
+    *value_text = text;
+}
+
+void SliderPainter::drawDisplayText(QPainter& painter,
+                                    const QRect& track,
+                                    const QString& label_text,
+                                    const QString& value_text,
+                                    Qt::Alignment alignment)
+{
+    if (alignment & Qt::AlignJustify)
+    {
+        if (!label_text.isEmpty())
+            painter.drawText(track, Qt::AlignLeft, label_text);
+
+        painter.drawText(track, Qt::AlignRight, value_text);
+    }
+    else
+    {
+        painter.drawText(track, alignment, value_text);
+    }
+}
+
+void SliderPainter::drawSlider(QPainter& painter, const SliderEditStyleOption& option, const QRegion& clip)
+{
+    const QRect track = trackRect(option.rect);
+
+    ValueMapper mapper;
+    mapper.configure(option.valueMapping, option.minimum, option.maximum, option.mappingExponent);
+    const int extent   = option.orientation == Qt::Horizontal ? track.width() : track.height();
+    const int position = mapper.toPosition(qBound(option.minimum, option.value, option.maximum), 0, extent);
+
+    // like SliderEdit, the text shows the value even if it lies outside the range
+    QString label_text;
+    QString value_text;
+    const bool has_text = (option.sliderComponents & SliderEdit::SliderComponent::Text) &&
+                          option.orientation == Qt::Horizontal;
+    if (has_text)
+    {
+        const NumberFormat::Separators separators =
+            option.localizedNumbers ? NumberFormat::Separators(option.locale) : NumberFormat::Separators();
+        const QString value = NumberFormat::toString(option.value, option.precision, separators);
+        displayText(option.label, value, option.unit, option.alignment, &label_text, &value_text);
+    }
+
+    painter.setClipRegion(clip);
+    painter.setFont(option.font);
+    painter.fillRect(clip.boundingRect(), option.palette.base());
+
+    drawTrack(painter,
+              option.palette,
+              clip,
+              track,
+              option.orientation,
+              position,
+              option.sliderComponents,
+              [&]()
+              {
+                  if (has_text)
+                      drawDisplayText(painter, track, label_text, value_text, option.alignment);
+              });
+}
+
+void SliderPainter::drawMarker(QPainter& painter, const QRect& track, Qt::Orientation orientation, int position)
+{
+    // measured from the bounds of the slider, and kept off its far edge
+    const int extent     = orientation == Qt::Horizontal ? track.width() : track.height();
+    const int marker_pos = qBound(0, Padding + position, extent);
+
+    QRect marker_rect;
+    if (orientation == Qt::Horizontal)
+        marker_rect = QRect(track.x() - Padding + marker_pos - 1, track.y(), 2, track.height() - 1);
+    else
+        marker_rect = QRect(track.x(), track.y() - Padding + track.height() - marker_pos + 1, track.width() - 1, 2);
+
+    painter.setRenderHint(QPainter::Antialiasing, false);
+    painter.setBrush(Qt::white);
+    painter.setPen(Qt::black);
+    painter.drawRect(marker_rect);
+    painter.setRenderHint(QPainter::Antialiasing);
+}
+
+qreal SliderPainter::editTextOrigin(const QRect& track, const SliderEditSession& edit, Qt::Alignment alignment)
+{
+    return track.x() + (alignment & Qt::AlignRight ? track.width() - edit.width() - 1 : 2);
+}
+
+void SliderPainter::drawEditText(QPainter& painter,
+                                 const QPalette& palette,
+                                 const QRegion& clip,
+                                 const QRect& track,
+                                 const SliderEditSession& edit,
+                                 qreal text_origin,
+                                 bool cursor_visible)
+{
+    const int cursor_width = 1;
+    const QRectF text_rect(text_origin, track.y(), track.x() + track.width() - text_origin, track.height());
+
+    // the advances are those of the text as drawn with the edit font
+    painter.setFont(edit.font);
+
+    const int text_cur_pos = qRound(text_origin + edit.advances[edit.cursorPos]) - cursor_width;
+    const int text_sel_pos = qRound(text_origin + edit.advances[edit.cursorPos + edit.selectionOffset]) - cursor_width;
+
+    if (edit.selectionOffset != 0)
+    {
+        const QRect selection_rect(QPoint(qMin(text_cur_pos, text_sel_pos), track.y()),
+                                   QPoint(qMax(text_cur_pos, text_sel_pos), track.bottom()));
+        painter.fillRect(selection_rect, palette.highlight());
+
+        // paint text inside the highlighted area
+        painter.setClipRegion(clip & selection_rect);
+        painter.setPen(palette.highlightedText().color());
+        painter.drawText(text_rect, Qt::AlignVCenter | Qt::AlignLeft, edit.text);
+
+        // paint text outside the highlighted area
+        painter.setClipRegion(clip.subtracted(selection_rect));
+        painter.setPen(palette.text().color());
+        painter.drawText(text_rect, Qt::AlignVCenter | Qt::AlignLeft, edit.text);
+        painter.setClipRegion(clip);
+    }
+    else
+    {
+        painter.setPen(palette.text().color());
+        painter.drawText(text_rect, Qt::AlignVCenter | Qt::AlignLeft, edit.text);
+    }
+
+    if (cursor_visible)
+    {
+        const int left = track.x() - Padding;
+        QLine cursor(qBound(left, text_cur_pos, left + track.width()), track.y(), text_cur_pos, track.bottom() + 1);
+
+        QPen pen(palette.text().color());
+        pen.setWidth(1);
+        painter.setRenderHint(QPainter::Antialiasing, false);
+        painter.setPen(pen);
+        painter.drawLine(cursor);
+        painter.setRenderHint(QPainter::Antialiasing);
+    }
+}
+
+void SliderPainter::drawFocusFrame(QPainter& painter, const QWidget* widget, const QRect& bounds)
+{
+    painter.setClipRect(bounds, Qt::NoClip);
+    QStyleOptionFocusRect opts;
+    opts.initFrom(widget);
+    opts.rect            = bounds.adjusted(1, 1, -1, -1);
+    opts.backgroundColor = widget->palette().window().color();
+    widget->style()->drawPrimitive(QStyle::PE_FrameFocusRect, &opts, &painter, widget);
+}
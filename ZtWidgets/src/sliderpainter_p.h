@@ -0,0 +1,158 @@
+/*
+ * Copyright (c) 2021 Victor Wåhlström
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ * claim that you wrote the original software. If you use this software
+ * in a product, an acknowledgment in the product documentation would be
+ * appreciated but is not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source
+ */
+
+
+#ifndef SLIDERPAINTER_H
+#define SLIDERPAINTER_H
+
+#include <ZtWidgets/slideredit.h>
+
+#include <QPainter>
+#include <QPalette>
+#include <QRegion>
+
+struct SliderEditSession;
+
+/**
+ * @brief Drawing code shared by all widgets which display sliders
+ *
+ * A slider is drawn within its bounds, inset by Padding. The inset rectangle is called the track. Positions along the
+ * track are measured in pixels from the minimum, which is the left end of horizontal sliders and the bottom end of
+ * vertical ones.
+ */
+class SliderPainter
+{
+  public:
+    /**
+     * @brief Space between the bounds of a slider and its track
+     */
+    static constexpr const int Padding = 2;
+
+    /**
+     * @brief The track of a slider with the given bounds
+     */
+    static QRect trackRect(const QRect& bounds)
+    {
+        return bounds.adjusted(Padding, Padding, -Padding, -Padding);
+    }
+
+    /**
+     * @brief The part of the track covered by the gauge
+     */
+    static QRect gaugeRect(const QRect& track, Qt::Orientation orientation, int position);
+
+    /**
+     * @brief Build the text displayed by a slider which is not being edited
+     * @param label_text Set to the label, drawn on its own, if the alignment is justified
+     * @param value_text Set to the value, unit and, unless justified, the label
+     */
+    static void displayText(const QString& label,
+                            const QString& value,
+                            const QString& unit,
+                            Qt::Alignment alignment,
+                            QString* label_text,
+                            QString* value_text);
+
+    /**
+     * @brief Draw text built by displayText() within the track
+     */
+    static void drawDisplayText(QPainter& painter,
+                                const QRect& track,
+                                const QString& label_text,
+                                const QString& value_text,
+                                Qt::Alignment alignment);
+
+    /**
+     * @brief Draw the gauge, text and marker of a slider which is not being edited
+     * @param draw_text Called to draw the text, once clipped to the gauge and once clipped to the rest of the track
+     *
+     * The background is not drawn, so that callers can draw on it first.
+     */
+    template<typename DrawText>
+    static void drawTrack(QPainter& painter,
+                          const QPalette& palette,
+                          const QRegion& clip,
+                          const QRect& track,
+                          Qt::Orientation orientation,
+                          int position,
+                          SliderEdit::SliderComponents components,
+                          const DrawText& draw_text)
+    {
+        if (components & SliderEdit::Gauge)
+        {
+            const QRect filled_rect = gaugeRect(track, orientation, position);
+            painter.fillRect(filled_rect & clip.boundingRect(), palette.highlight());
+
+            painter.setClipRegion(clip & filled_rect);
+            painter.setPen(palette.highlightedText().color());
+            draw_text();
+
+            QRect empty_rect(track.x() + position, track.y(), track.width() - position, track.height());
+            painter.setClipRegion(clip & empty_rect);
+        }
+
+        painter.setPen(palette.text().color());
+        draw_text();
+        painter.setClipRegion(clip);
+
+        if (components & SliderEdit::Marker)
+            drawMarker(painter, track, orientation, position);
+    }
+
+    /**
+     * @brief Draw the background, gauge, text and marker of a slider which is not being edited
+     * @param clip The area to draw, within the track of the slider
+     *
+     * Formats the text and maps the value on every call, so widgets which draw the same slider repeatedly may prefer
+     * to cache those and call drawTrack() instead.
+     */
+    static void drawSlider(QPainter& painter, const SliderEditStyleOption& option, const QRegion& clip);
+
+    /**
+     * @brief Draw the marker at a position along the track
+     */
+    static void drawMarker(QPainter& painter, const QRect& track, Qt::Orientation orientation, int position);
+
+    /**
+     * @brief Left edge of the text being edited
+     */
+    static qreal editTextOrigin(const QRect& track, const SliderEditSession& edit, Qt::Alignment alignment);
+
+    /**
+     * @brief Draw the text being edited, its selection and the cursor
+     */
+    static void drawEditText(QPainter& painter,
+                             const QPalette& palette,
+                             const QRegion& clip,
+                             const QRect& track,
+                             const SliderEditSession& edit,
+                             qreal text_origin,
+                             bool cursor_visible);
+
+    /**
+     * @brief Draw the focus frame of a slider
+     * @param bounds Bounds of the slider within widget
+     */
+    static void drawFocusFrame(QPainter& painter, const QWidget* widget, const QRect& bounds);
+};
+
+#endif // SLIDERPAINTER_H
@@ -0,0 +1,448 @@
+/*
+ * Copyright (c) 2021 Victor Wåhlström
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ * claim that you wrote the original software. If you use this software
+ * in a product, an acknowledgment in the product documentation would be
+ * appreciated but is not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source
+ */
+
+
+#include "sliderrows_p.h"
+
+#include "cursorblinkclock_p.h"
+#include "slidereditsession_p.h"
+#include "sliderpainter_p.h"
+#include "styleresources_p.h"
+
+#include <QKeyEvent>
+#include <QPainter>
+#include <QWidget>
+
+// time the edit cursor is shown solid before it starts blinking, when entering edit mode and after any other input
+static constexpr const int S_CURSOR_BLINK_DELAY    = 1000;
+static constexpr const int S_CURSOR_ACTIVITY_DELAY = 500;
+
+SliderRowController::SliderRowController(QWidget* widget)
+    : m_Edit(nullptr)
+    , m_Tracker(
+          [this]()
+          {
+              if (isValid(m_ChangingRow))
+                  emitValueChanging(m_ChangingRow, row(m_ChangingRow).value);
+          })
+    , m_CurrentRow(-1)
+    , m_EditRow(-1)
+    , m_ChangingRow(-1)
+    , m_PressedRow(-1)
+    , m_Alignment(Qt::AlignCenter)
+    , m_SliderComponents(SliderEdit::SliderComponent::Text | SliderEdit::SliderComponent::Gauge)
+    , m_KeyStepping(false)
+    , m_Widget(widget)
+{}
+
+SliderRowController::~SliderRowController()
+{
+    delete m_Edit;
+}
+
+void SliderRowController::scrollTo(int) {}
+
+const ValueMapper& SliderRowController::mapper(const SliderRow& row) const
+{
+    m_Mapper.configure(row.valueMapping, row.min, row.max, row.mappingExponent);
+    return m_Mapper;
+}
+
+QString SliderRowController::toString(const SliderRow& row, qreal value, bool grouping) const
+{
+    NumberFormat::Separators separators = m_Separators;
+    separators.grouping                 = separators.grouping && grouping;
+    return NumberFormat::toString(value, row.precision, separators);
+}
+
+int SliderRowController::rowHeight() const
+{
+    return StyleResources::fontMetrics(m_Widget->font()).height() + SliderPainter::Padding * 2;
+}
+
+qreal SliderRowController::valueFromMousePos(int index, const QPoint& pos) const
+{
+    const QRect r = rowRect(index);
+    const int p   = qBound(r.x(), pos.x(), r.x() + r.width());
+    return mapper(row(index)).fromPosition(p, r.x(), r.x() + r.width());
+}
+
+bool SliderRowController::changeValue(int index, qreal value)
+{
+    const SliderRow r = row(index);
+    value             = qBound(r.min, value, r.max);
+    if (value == r.value)
+        return false;
+
+    storeValue(index, value);
+    updateRow(index);
+    return true;
+}
+
+void SliderRowController::updateRow(int index)
+{
+    m_Widget->update(rowRect(index));
+}
+
+void SliderRowController::setCurrentRow(int index)
+{
+    if (!isValid(index) || index == m_CurrentRow)
+        return;
+
+    if (isEditing())
+        endEdit();
+
+    // the focus frame moves
+    if (isValid(m_CurrentRow))
+        updateRow(m_CurrentRow);
+    m_CurrentRow = index;
+    scrollTo(index);
+    updateRow(index);
+}
+
+void SliderRowController::beginEdit(int index)
+{
+    if (!isValid(index))
+        return;
+
+    setCurrentRow(index);
+
+    // digit grouping would get in the way of editing
+    const SliderRow r = row(index);
+    delete m_Edit;
+    m_Edit    = new SliderEditSession(m_Widget->font(), toString(r, r.value, false));
+    m_EditRow = index;
+    CursorBlinkClock::activity(m_Widget, S_CURSOR_BLINK_DELAY);
+    m_Widget->setCursor(Qt::IBeamCursor);
+    updateRow(index);
+}
+
+void SliderRowController::endEdit()
+{
+    if (m_Edit && m_Edit->originalText != m_Edit->text)
+    {
+        bool valid;
+        const qreal val = m_Edit->text.toDouble(&valid);
+        if (!valid)
+        {
+            cancelEdit();
+            return;
+        }
+
+        const int index = m_EditRow;
+        if (changeValue(index, val))
+            emitValueChanged(index, row(index).value);
+    }
+
+    cancelEdit();
+}
+
+void SliderRowController::cancelEdit()
+{
+    if (!m_Edit)
+        return;
+
+    delete m_Edit;
+    m_Edit = nullptr;
+    updateRow(m_EditRow);
+    m_EditRow = -1;
+    CursorBlinkClock::stop(m_Widget);
+    m_Widget->unsetCursor();
+}
+
+qreal SliderRowController::editTextOrigin() const
+{
+    const QRect r = SliderPainter::trackRect(rowRect(m_EditRow));
+    return SliderPainter::editTextOrigin(r, *m_Edit, m_Alignment);
+}
+
+quint32 SliderRowController::toEditCursorPos(int pos) const
+{
+    return static_cast<quint32>(m_Edit->cursorAt(pos - editTextOrigin()));
+}
+
+void SliderRowController::finishInteraction()
+{
+    const int index = m_ChangingRow;
+    m_ChangingRow   = -1;
+    m_KeyStepping   = false;
+    m_Tracker.finish();
+    if (isValid(index))
+        emitValueChanged(index, row(index).value);
+}
+
+void SliderRowController::resetInteraction()
+{
+    // interactions refer to rows by index, which may no longer be the same rows
+    cancelEdit();
+    m_Tracker.finish();
+    m_ChangingRow = -1;
+    m_PressedRow  = -1;
+    m_KeyStepping = false;
+    m_CurrentRow  = qMin(m_CurrentRow, rowCount() - 1);
+    if (m_CurrentRow < 0 && rowCount() > 0)
+        m_CurrentRow = 0;
+}
+
+void SliderRowController::drawRow(QPainter& painter, int index, const QRect& bounds, const QRegion& clip) const
+{
+    const QPalette& palette = m_Widget->palette();
+
+    if (index == m_EditRow)
+    {
+        painter.setClipRegion(clip);
+        painter.setFont(m_Widget->font());
+        painter.fillRect(clip.boundingRect(), palette.base());
+
+        const QRect track = SliderPainter::trackRect(bounds);
+        SliderPainter::drawEditText(
+            painter, palette, clip, track, *m_Edit, editTextOrigin(), CursorBlinkClock::cursorVisible(m_Widget));
+        return;
+    }
+
+    const SliderRow r = row(index);
+
+    // rows are drawn like any other slider drawn without a widget
+    SliderEditStyleOption option;
+    option.rect             = bounds;
+    option.palette          = palette;
+    option.font             = m_Widget->font();
+    option.label            = r.label;
+    option.unit             = r.unit;
+    option.value            = r.value;
+    option.minimum          = r.min;
+    option.maximum          = r.max;
+    option.mappingExponent  = r.mappingExponent;
+    option.precision        = r.precision;
+    option.alignment        = m_Alignment;
+    option.sliderComponents = m_SliderComponents;
+    option.valueMapping     = r.valueMapping;
+    SliderPainter::drawSlider(painter, option, clip);
+}
+
+void SliderRowController::mousePressEvent(QMouseEvent* event)
+{
+    const int index = rowAt(event->pos());
+
+    // pressing another row ends the edit, like moving the focus to another SliderEdit would
+    if (isEditing() && index != m_EditRow)
+        endEdit();
+
+    m_MousePressPos = event->pos();
+    m_PressedRow    = index;
+    if (index < 0)
+        return;
+
+    setCurrentRow(index);
+    if (isEditing())
+    {
+        m_Edit->cursorPos       = toEditCursorPos(event->pos().x());
+        m_Edit->selectionOffset = 0;
+        updateRow(index);
+    }
+}
+
+void SliderRowController::mouseMoveEvent(QMouseEvent* event)
+{
+    const int index = m_PressedRow;
+    if (!isValid(index))
+        return;
+
+    if (isEditing())
+    {
+        CursorBlinkClock::hold(m_Widget);
+        const quint32 anchor    = toEditCursorPos(m_MousePressPos.x());
+        m_Edit->cursorPos       = toEditCursorPos(event->pos().x());
+        m_Edit->selectionOffset = anchor - m_Edit->cursorPos;
+        updateRow(index);
+    }
+    else
+    {
+        changeValue(index, valueFromMousePos(index, event->pos()));
+        m_ChangingRow = index;
+        m_Tracker.changing();
+    }
+}
+
+void SliderRowController::mouseReleaseEvent(QMouseEvent* event)
+{
+    const int index = m_PressedRow;
+    m_PressedRow    = -1;
+    if (!isValid(index))
+        return;
+
+    if (isEditing())
+    {
+        CursorBlinkClock::activity(m_Widget, S_CURSOR_ACTIVITY_DELAY);
+    }
+    else if (event->pos() == m_MousePressPos)
+    {
+        beginEdit(index);
+    }
+    else
+    {
+        changeValue(index, valueFromMousePos(index, event->pos()));
+        m_ChangingRow = index;
+        finishInteraction();
+    }
+}
+
+void SliderRowController::mouseDoubleClickEvent(QMouseEvent* event)
+{
+    const int index = rowAt(event->pos());
+    if (index < 0)
+        return;
+
+    if (!isEditing())
+        beginEdit(index);
+
+    m_Edit->cursorPos       = m_Edit->text.size();
+    m_Edit->selectionOffset = -m_Edit->text.size();
+    updateRow(index);
+}
+
+bool SliderRowController::keyPressEvent(QKeyEvent* event)
+{
+    const int key   = event->key();
+    const int index = m_CurrentRow;
+    if (!isValid(index))
+        return false;
+
+    // directly enter edit mode if an input key is pressed
+    if (!isEditing() && SliderEditSession::isInputKey(key))
+        beginEdit(index);
+
+    if (isEditing())
+    {
+        CursorBlinkClock::activity(m_Widget, S_CURSOR_ACTIVITY_DELAY);
+
+        if (key == Qt::Key_Escape)
+            cancelEdit();
+        else if (key == Qt::Key_Enter || key == Qt::Key_Return)
+            endEdit();
+        else if (m_Edit->keyPress(event, m_Separators))
+            updateRow(m_EditRow);
+
+        return true;
+    }
+
+    if (key == Qt::Key_Up || key == Qt::Key_Down)
+    {
+        // stepping applies to the current row, so finish it before moving on
+        if (m_KeyStepping)
+            finishInteraction();
+
+        setCurrentRow(index + (key == Qt::Key_Down ? 1 : -1));
+        return true;
+    }
+
+    const SliderRow r = row(index);
+
+    qreal step = 0;
+    if (key == Qt::Key_Left)
+        step = -r.singleStep;
+    else if (key == Qt::Key_Right)
+        step = r.singleStep;
+    else if (key == Qt::Key_PageDown)
+        step = -r.pageStep;
+    else if (key == Qt::Key_PageUp)
+        step = r.pageStep;
+
+    if (step == 0)
+        return false;
+
+    // holding a key down is treated like dragging the slider; valueChanged is emitted when the key is released
+    changeValue(index, r.value + step);
+    m_ChangingRow = index;
+    m_KeyStepping = true;
+    m_Tracker.changing();
+    return true;
+}
+
+bool SliderRowController::keyReleaseEvent(QKeyEvent* event)
+{
+    if (event->isAutoRepeat() || !m_KeyStepping)
+        return false;
+
+    finishInteraction();
+    return true;
+}
+
+void SliderRowController::focusInEvent(QFocusEvent* event)
+{
+    const int reason = event->reason();
+    if (reason == Qt::TabFocusReason)
+        beginEdit(0);
+    else if (reason == Qt::BacktabFocusReason)
+        beginEdit(rowCount() - 1);
+    else if (isValid(m_CurrentRow))
+        updateRow(m_CurrentRow);
+}
+
+void SliderRowController::focusOutEvent(QFocusEvent* event)
+{
+    // the key release will not be delivered to this widget
+    if (m_KeyStepping)
+        finishInteraction();
+
+    switch (event->reason())
+    {
+        case Qt::MouseFocusReason:
+        case Qt::TabFocusReason:
+        case Qt::BacktabFocusReason:
+            endEdit();
+            break;
+        default:
+            cancelEdit();
+            break;
+    }
+
+    if (isValid(m_CurrentRow))
+        updateRow(m_CurrentRow);
+}
+
+bool SliderRowController::focusNextPrevChild(bool next)
+{
+    // Tab moves through the rows before moving on to the next widget
+    const int index = m_CurrentRow + (next ? 1 : -1);
+    if (!isEditing() || !isValid(index))
+        return false;
+
+    beginEdit(index);
+    return true;
+}
+
+void SliderRowController::changeEvent(QEvent* event)
+{
+    if (event->type() == QEvent::FontChange && isEditing())
+    {
+        m_Edit->setFont(m_Widget->font());
+    }
+    else if (event->type() == QEvent::ActivationChange && isEditing())
+    {
+        // the blink clock stops ticking for inactive windows
+        if (m_Widget->isActiveWindow())
+            CursorBlinkClock::activity(m_Widget, S_CURSOR_ACTIVITY_DELAY);
+        else
+            CursorBlinkClock::hold(m_Widget);
+    }
+}
@@ -0,0 +1,145 @@
+/*
+ * Copyright (c) 2021 Victor Wåhlström
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ * claim that you wrote the original software. If you use this software
+ * in a product, an acknowledgment in the product documentation would be
+ * appreciated but is not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source
+ */
+
+
+#ifndef SLIDERROWS_H
+#define SLIDERROWS_H
+
+#include "changetracker_p.h"
+#include "numberformat_p.h"
+#include "valuemapping_p.h"
+
+#include <ZtWidgets/slideredit.h>
+
+#include <QPoint>
+#include <QString>
+
+class QEvent;
+class QFocusEvent;
+class QKeyEvent;
+class QMouseEvent;
+class QPainter;
+class QRegion;
+struct SliderEditSession;
+
+//! @cond Doxygen_Suppress
+// everything needed to draw and edit one slider of a widget which draws many
+struct SliderRow
+{
+    QString label;
+    QString unit;
+    qreal value;
+    qreal min;
+    qreal max;
+    qreal singleStep;
+    qreal pageStep;
+    qreal mappingExponent;
+    quint32 precision;
+    SliderEdit::ValueMapping valueMapping;
+};
+
+/**
+ * @brief Draws and edits horizontal sliders stacked in rows of a single widget
+ *
+ * Implements the interaction of SliderEdit for any number of rows, of which only one at a time is dragged, stepped or
+ * edited as text. Widgets provide access to their rows by overriding the pure virtual functions, and forward their
+ * input events.
+ */
+class SliderRowController
+{
+    Q_DISABLE_COPY(SliderRowController)
+
+  public:
+    /**
+     * @brief Vertical space between two rows
+     */
+    static constexpr const int Spacing = 2;
+
+    /**
+     * @param widget The widget the rows are drawn on
+     */
+    explicit SliderRowController(QWidget* widget);
+    virtual ~SliderRowController();
+
+    virtual int rowCount() const                           = 0;
+    virtual SliderRow row(int index) const                 = 0;
+    virtual QRect rowRect(int index) const                 = 0;
+    virtual int rowAt(const QPoint& pos) const             = 0;
+    virtual void emitValueChanged(int index, qreal value)  = 0;
+    virtual void emitValueChanging(int index, qreal value) = 0;
+
+    // stores a value which has already been clamped to the range of the row
+    virtual void storeValue(int index, qreal value) = 0;
+
+    // called when a row becomes the current row
+    virtual void scrollTo(int index);
+
+    bool isValid(int index) const { return index >= 0 && index < rowCount(); }
+    const ValueMapper& mapper(const SliderRow& row) const;
+    QString toString(const SliderRow& row, qreal value, bool grouping = true) const;
+    int rowHeight() const;
+    qreal valueFromMousePos(int index, const QPoint& pos) const;
+    bool changeValue(int index, qreal value);
+    void updateRow(int index);
+    void setCurrentRow(int index);
+    void beginEdit(int index);
+    void endEdit();
+    void cancelEdit();
+    bool isEditing() const { return m_Edit != nullptr; }
+    qreal editTextOrigin() const;
+    quint32 toEditCursorPos(int pos) const;
+    void finishInteraction();
+    void resetInteraction();
+    void drawRow(QPainter& painter, int index, const QRect& bounds, const QRegion& clip) const;
+
+    void mousePressEvent(QMouseEvent* event);
+    void mouseMoveEvent(QMouseEvent* event);
+    void mouseReleaseEvent(QMouseEvent* event);
+    void mouseDoubleClickEvent(QMouseEvent* event);
+    bool keyPressEvent(QKeyEvent* event);
+    bool keyReleaseEvent(QKeyEvent* event);
+    void focusInEvent(QFocusEvent* event);
+    void focusOutEvent(QFocusEvent* event);
+    bool focusNextPrevChild(bool next);
+    void changeEvent(QEvent* event);
+
+    SliderEditSession* m_Edit;
+    ChangeTracker m_Tracker;
+    NumberFormat::Separators m_Separators;
+    // configured for one row at a time, which only costs a few arithmetic operations
+    mutable ValueMapper m_Mapper;
+    QPoint m_MousePressPos;
+    int m_CurrentRow;
+    int m_EditRow;
+    // the row being dragged or stepped with the keyboard
+    int m_ChangingRow;
+    int m_PressedRow;
+    Qt::Alignment m_Alignment;
+    SliderEdit::SliderComponents m_SliderComponents;
+    bool m_KeyStepping;
+
+  protected:
+    QWidget* m_Widget;
+};
+//! @endcond
+
+#endif // SLIDERROWS_H
@@ -0,0 +1,56 @@
+/*
+ * Copyright (c) 2021 Victor Wåhlström
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ * claim that you wrote the original software. If you use this software
+ * in a product, an acknowledgment in the product documentation would be
+ * appreciated but is not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source
+ */
+
+
+#include <ZtWidgets/slidervaluesource.h>
+
+#include <cstring>
+
+static_assert(sizeof(double) == sizeof(quint64), "doubles must be 64 bits wide");
+
+static quint64 toBits(double value)
+{
+    quint64 bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+static double fromBits(quint64 bits)
+{
+    double value;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+SliderValueSource::SliderValueSource(qreal value)
+    : m_Bits(toBits(value))
+{}
+
+void SliderValueSource::setValue(qreal value)
+{
+    m_Bits.storeRelease(toBits(value));
+}
+
+qreal SliderValueSource::value() const
+{
+    return fromBits(m_Bits.loadAcquire());
+}
@@ -0,0 +1,264 @@
+/*
+ * Copyright (c) 2021 Victor Wåhlström
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ * claim that you wrote the original software. If you use this software
+ * in a product, an acknowledgment in the product documentation would be
+ * appreciated but is not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source
+ */
+
+
+#include <ZtWidgets/slidervaluestore.h>
+
+//! @cond Doxygen_Suppress
+class SliderValueStorePrivate
+{
+    Q_DISABLE_COPY(SliderValueStorePrivate)
+
+  public:
+    SliderValueStorePrivate();
+
+    bool isValid(int index) const { return index >= 0 && index < m_Values.size(); }
+    int clampCount(int first, int count) const { return qMin(count, m_Values.size() - first); }
+
+    QVector<qreal> m_Values;
+    QVector<qreal> m_Minimums;
+    QVector<qreal> m_Maximums;
+    QVector<quint8> m_Precisions;
+    QVector<quint8> m_Mappings;
+    QVector<QString> m_Labels;
+    qreal m_MappingExponent;
+};
+
+SliderValueStorePrivate::SliderValueStorePrivate()
+    : m_MappingExponent(2.0)
+{}
+//! @endcond
+
+SliderValueStore::SliderValueStore(QObject* parent)
+    : QObject(parent)
+    , m_Impl(new SliderValueStorePrivate())
+{}
+
+SliderValueStore::~SliderValueStore()
+{
+    delete m_Impl;
+}
+
+void SliderValueStore::resize(int count)
+{
+    count = qMax(count, 0);
+    if (count == m_Impl->m_Values.size())
+        return;
+
+    const int old_count = m_Impl->m_Values.size();
+
+    m_Impl->m_Values.resize(count);
+    m_Impl->m_Minimums.resize(count);
+    m_Impl->m_Maximums.resize(count);
+    m_Impl->m_Precisions.resize(count);
+    m_Impl->m_Mappings.resize(count);
+    if (!m_Impl->m_Labels.isEmpty())
+        m_Impl->m_Labels.resize(count);
+
+    for (int i = old_count; i < count; ++i)
+    {
+        m_Impl->m_Values[i]     = 0;
+        m_Impl->m_Minimums[i]   = 0;
+        m_Impl->m_Maximums[i]   = 1;
+        m_Impl->m_Precisions[i] = 3;
+        m_Impl->m_Mappings[i]   = SliderEdit::LinearScale;
+    }
+
+    Q_EMIT countChanged(count);
+}
+
+int SliderValueStore::count() const
+{
+    return m_Impl->m_Values.size();
+}
+
+qreal SliderValueStore::value(int index) const
+{
+    return m_Impl->isValid(index) ? m_Impl->m_Values[index] : 0;
+}
+
+void SliderValueStore::setValue(int index, qreal value)
+{
+    if (!m_Impl->isValid(index))
+        return;
+
+    value = qBound(m_Impl->m_Minimums[index], value, m_Impl->m_Maximums[index]);
+    if (m_Impl->m_Values[index] == value)
+        return;
+
+    m_Impl->m_Values[index] = value;
+    Q_EMIT rowsChanged(index, index);
+}
+
+void SliderValueStore::setValues(int first, const qreal* values, int count)
+{
+    if (!m_Impl->isValid(first) || !values)
+        return;
+
+    count = m_Impl->clampCount(first, count);
+    if (count <= 0)
+        return;
+
+    qreal* dst         = m_Impl->m_Values.data() + first;
+    const qreal* lower = m_Impl->m_Minimums.constData() + first;
+    const qreal* upper = m_Impl->m_Maximums.constData() + first;
+    for (int i = 0; i < count; ++i)
+        dst[i] = qBound(lower[i], values[i], upper[i]);
+
+    Q_EMIT rowsChanged(first, first + count - 1);
+}
+
+void SliderValueStore::setValues(int first, const QVector<qreal>& values)
+{
+    setValues(first, values.constData(), values.size());
+}
+
+const qreal* SliderValueStore::values() const
+{
+    return m_Impl->m_Values.constData();
+}
+
+void SliderValueStore::setRange(int index, qreal minimum, qreal maximum)
+{
+    setRanges(index, &minimum, &maximum, 1);
+}
+
+void SliderValueStore::setRanges(int first, const qreal* minimums, const qreal* maximums, int count)
+{
+    if (!m_Impl->isValid(first) || !minimums || !maximums)
+        return;
+
+    count = m_Impl->clampCount(first, count);
+    if (count <= 0)
+        return;
+
+    qreal* lower = m_Impl->m_Minimums.data() + first;
+    qreal* upper = m_Impl->m_Maximums.data() + first;
+    qreal* dst   = m_Impl->m_Values.data() + first;
+    for (int i = 0; i < count; ++i)
+    {
+        lower[i] = qMin(minimums[i], maximums[i]);
+        upper[i] = qMax(minimums[i], maximums[i]);
+        dst[i]   = qBound(lower[i], dst[i], upper[i]);
+    }
+
+    Q_EMIT rowsChanged(first, first + count - 1);
+}
+
+qreal SliderValueStore::minimum(int index) const
+{
+    return m_Impl->isValid(index) ? m_Impl->m_Minimums[index] : 0;
+}
+
+qreal SliderValueStore::maximum(int index) const
+{
+    return m_Impl->isValid(index) ? m_Impl->m_Maximums[index] : 0;
+}
+
+const qreal* SliderValueStore::minimums() const
+{
+    return m_Impl->m_Minimums.constData();
+}
+
+const qreal* SliderValueStore::maximums() const
+{
+    return m_Impl->m_Maximums.constData();
+}
+
+void SliderValueStore::setPrecision(int index, quint32 precision)
+{
+    if (!m_Impl->isValid(index))
+        return;
+
+    const quint8 stored = static_cast<quint8>(qMin<quint32>(precision, 255));
+    if (m_Impl->m_Precisions[index] == stored)
+        return;
+
+    m_Impl->m_Precisions[index] = stored;
+    Q_EMIT rowsChanged(index, index);
+}
+
+quint32 SliderValueStore::precision(int index) const
+{
+    return m_Impl->isValid(index) ? m_Impl->m_Precisions[index] : 0;
+}
+
+void SliderValueStore::setValueMapping(int index, SliderEdit::ValueMapping mapping)
+{
+    if (!m_Impl->isValid(index))
+        return;
+
+    if (mapping == SliderEdit::CustomScale)
+        mapping = SliderEdit::LinearScale;
+
+    if (m_Impl->m_Mappings[index] == mapping)
+        return;
+
+    m_Impl->m_Mappings[index] = static_cast<quint8>(mapping);
+    Q_EMIT rowsChanged(index, index);
+}
+
+SliderEdit::ValueMapping SliderValueStore::valueMapping(int index) const
+{
+    return m_Impl->isValid(index) ? static_cast<SliderEdit::ValueMapping>(m_Impl->m_Mappings[index])
+                                  : SliderEdit::LinearScale;
+}
+
+void SliderValueStore::setMappingExponent(qreal exponent)
+{
+    if (m_Impl->m_MappingExponent == exponent)
+        return;
+
+    m_Impl->m_MappingExponent = exponent;
+    if (!m_Impl->m_Values.isEmpty())
+        Q_EMIT rowsChanged(0, m_Impl->m_Values.size() - 1);
+}
+
+qreal SliderValueStore::mappingExponent() const
+{
+    return m_Impl->m_MappingExponent;
+}
+
+void SliderValueStore::setLabel(int index, const QString& label)
+{
+    if (!m_Impl->isValid(index))
+        return;
+
+    if (m_Impl->m_Labels.isEmpty())
+    {
+        if (label.isEmpty())
+            return;
+
+        m_Impl->m_Labels.resize(m_Impl->m_Values.size());
+    }
+
+    if (m_Impl->m_Labels[index] == label)
+        return;
+
+    m_Impl->m_Labels[index] = label;
+    Q_EMIT rowsChanged(index, index);
+}
+
+QString SliderValueStore::label(int index) const
+{
+    return index >= 0 && index < m_Impl->m_Labels.size() ? m_Impl->m_Labels[index] : QString();
+}
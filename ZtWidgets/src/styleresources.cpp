@@ -0,0 +1,226 @@
+/*
+ * Copyright (c) 2021 Victor Wåhlström
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ * claim that you wrote the original software. If you use this software
+ * in a product, an acknowledgment in the product documentation would be
+ * appreciated but is not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source
+ */
+
+
+#include "styleresources_p.h"
+
+#include "color_utils_p.h"
+
+#include <QFontDatabase>
+#include <QGuiApplication>
+#include <QHash>
+#include <QLinearGradient>
+#include <QPainter>
+#include <QPointer>
+#include <QtMath>
+
+// the number of distinct fonts and gradient images is small in practice; start over rather than track usage
+static constexpr const int S_MAX_CACHED_FONT_METRICS    = 16;
+static constexpr const int S_MAX_CACHED_GRADIENT_IMAGES = 64;
+
+static bool isBright(const QColor& c)
+{
+    return qSqrt(qPow(c.redF(), 2) * 0.299f + qPow(c.greenF(), 2) * 0.587f + qPow(c.blueF(), 2) * 0.114f) > 0.6f;
+}
+
+static QGradientStops createGradientStops(StyleResources::Gradient gradient)
+{
+    QGradientStops stops;
+    switch (gradient)
+    {
+        case StyleResources::BlackWhite:
+            stops << QGradientStop(0.0, Qt::black) << QGradientStop(1.0, Qt::white);
+            break;
+        case StyleResources::Red:
+            stops << QGradientStop(0.0, Qt::black) << QGradientStop(1.0, Qt::red);
+            break;
+        case StyleResources::Green:
+            stops << QGradientStop(0.0, Qt::black) << QGradientStop(1.0, Qt::green);
+            break;
+        case StyleResources::Blue:
+            stops << QGradientStop(0.0, Qt::black) << QGradientStop(1.0, Qt::blue);
+            break;
+        case StyleResources::Alpha:
+            stops << QGradientStop(0.0, QColor(255, 255, 255, 0)) << QGradientStop(1.0, Qt::white);
+            break;
+        case StyleResources::Hue:
+            for (int i = 0; i <= 10; ++i)
+            {
+                // the hue wraps around to red at the end
+                const qreal step = i / 10.0;
+                stops << QGradientStop(step, QColor::fromHsvF(i < 10 ? step : 0.0, 1.0, 1.0));
+            }
+            break;
+        case StyleResources::GradientCount:
+            break;
+    }
+
+    return stops;
+}
+
+//! @cond Doxygen_Suppress
+class StyleResourceCache : public QObject
+{
+    Q_DISABLE_COPY(StyleResourceCache)
+
+  public:
+    explicit StyleResourceCache(QObject* parent);
+
+    static StyleResourceCache* instance();
+
+    void invalidate();
+
+    QFont m_PickerFont;
+    QHash<QFont, QFontMetrics> m_FontMetrics;
+    QHash<quint64, QImage> m_GradientImages;
+    QGradientStops m_GradientStops[StyleResources::GradientCount];
+    QColor m_ContrastTextColors[StyleResources::GradientCount];
+    quint64 m_Generation;
+    bool m_PickerFontValid : 1;
+};
+
+StyleResourceCache::StyleResourceCache(QObject* parent)
+    : QObject(parent)
+    , m_Generation(0)
+    , m_PickerFontValid(false)
+{
+    // gradients do not depend on the application state, so they are created once and never invalidated
+    for (int i = 0; i < StyleResources::GradientCount; ++i)
+    {
+        m_GradientStops[i]      = createGradientStops(static_cast<StyleResources::Gradient>(i));
+        m_ContrastTextColors[i] = isBright(m_GradientStops[i].last().second) ? Qt::black : Qt::white;
+    }
+
+    // cached fonts only depend on the application font and palette. Neither the application nor its widgets changing
+    // style affect anything here.
+    if (QGuiApplication* app = qobject_cast<QGuiApplication*>(parent))
+    {
+        connect(app, &QGuiApplication::fontChanged, this, &StyleResourceCache::invalidate);
+        connect(app, &QGuiApplication::paletteChanged, this, &StyleResourceCache::invalidate);
+    }
+}
+
+StyleResourceCache* StyleResourceCache::instance()
+{
+    // owned by the application object, so that no fonts outlive it. A new application gets a new cache.
+    static QPointer<StyleResourceCache> s_Cache;
+    if (!s_Cache)
+        s_Cache = new StyleResourceCache(QCoreApplication::instance());
+
+    return s_Cache;
+}
+
+void StyleResourceCache::invalidate()
+{
+    m_PickerFontValid = false;
+    m_FontMetrics.clear();
+    m_GradientImages.clear();
+    ++m_Generation;
+}
+//! @endcond
+
+QFont StyleResources::pickerFont()
+{
+    StyleResourceCache* cache = StyleResourceCache::instance();
+    if (!cache->m_PickerFontValid)
+    {
+        QFont font = QFontDatabase::systemFont(QFontDatabase::FixedFont);
+        font.setStyleHint(QFont::TypeWriter);
+        font.setWeight(QFont::ExtraBold);
+        font.setStyleStrategy(QFont::ForceOutline);
+
+        cache->m_PickerFont      = font;
+        cache->m_PickerFontValid = true;
+    }
+
+    return cache->m_PickerFont;
+}
+
+QFontMetrics StyleResources::fontMetrics(const QFont& font)
+{
+    StyleResourceCache* cache = StyleResourceCache::instance();
+
+    auto it = cache->m_FontMetrics.constFind(font);
+    if (it != cache->m_FontMetrics.constEnd())
+        return it.value();
+
+    if (cache->m_FontMetrics.size() >= S_MAX_CACHED_FONT_METRICS)
+        cache->m_FontMetrics.clear();
+
+    return cache->m_FontMetrics.insert(font, QFontMetrics(font)).value();
+}
+
+QGradientStops StyleResources::gradientStops(Gradient gradient)
+{
+    return StyleResourceCache::instance()->m_GradientStops[gradient];
+}
+
+QColor StyleResources::contrastTextColor(Gradient gradient)
+{
+    return StyleResourceCache::instance()->m_ContrastTextColors[gradient];
+}
+
+QImage StyleResources::gradientImage(Gradient gradient, const QSize& size, Qt::Orientation orientation)
+{
+    if (size.isEmpty())
+        return QImage();
+
+    StyleResourceCache* cache = StyleResourceCache::instance();
+
+    const quint64 key = (static_cast<quint64>(gradient) << 48) | (static_cast<quint64>(orientation) << 40) |
+                        (static_cast<quint64>(size.width() & 0xfffff) << 20) |
+                        static_cast<quint64>(size.height() & 0xfffff);
+
+    auto it = cache->m_GradientImages.constFind(key);
+    if (it != cache->m_GradientImages.constEnd())
+        return it.value();
+
+    QImage img(size, QImage::Format_ARGB32_Premultiplied);
+    img.fill(0);
+
+    QRect r = img.rect();
+    QPainter painter(&img);
+
+    quint32 checker_size = qMin(r.width(), r.height()) / 2;
+    drawCheckerboard(painter, r, checker_size);
+
+    QLinearGradient g;
+    if (orientation == Qt::Horizontal)
+        g = QLinearGradient(QPointF(0.0f, 0.0f), QPointF((float)size.width(), 0.0f));
+    else
+        g = QLinearGradient(QPointF(0.0f, (float)size.height()), QPointF(0.0f, 0.0f));
+
+    g.setStops(cache->m_GradientStops[gradient]);
+    painter.fillRect(r, g);
+    painter.end();
+
+    if (cache->m_GradientImages.size() >= S_MAX_CACHED_GRADIENT_IMAGES)
+        cache->m_GradientImages.clear();
+
+    cache->m_GradientImages.insert(key, img);
+    return img;
+}
+
+quint64 StyleResources::generation()
+{
+    return StyleResourceCache::instance()->m_Generation;
+}
@@ -0,0 +1,95 @@
+/*
+ * Copyright (c) 2021 Victor Wåhlström
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ * claim that you wrote the original software. If you use this software
+ * in a product, an acknowledgment in the product documentation would be
+ * appreciated but is not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source
+ */
+
+
+#ifndef STYLERESOURCES_H
+#define STYLERESOURCES_H
+
+#include <QColor>
+#include <QFont>
+#include <QFontMetrics>
+#include <QGradient>
+#include <QImage>
+
+/**
+ * @brief Process-wide cache of fonts, font metrics and gradient definitions shared between widget instances
+ *
+ * Resources are created on first use and handed out as implicitly shared copies. Everything is discarded when the
+ * application font or palette changes, which also increments generation().
+ *
+ * @note Must only be used from the GUI thread
+ */
+class StyleResources
+{
+  public:
+    /**
+     * @brief Gradients used by the color sliders
+     */
+    enum Gradient
+    {
+        BlackWhite,
+        Red,
+        Green,
+        Blue,
+        Alpha,
+        Hue,
+        GradientCount,
+    };
+
+    /**
+     * @brief Get the fixed width font used by ColorPicker
+     */
+    static QFont pickerFont();
+
+    /**
+     * @brief Get metrics for a font
+     *
+     * Equivalent to constructing QFontMetrics(font), but shared between all callers using the same font.
+     */
+    static QFontMetrics fontMetrics(const QFont& font);
+
+    /**
+     * @brief Get the color stops of a gradient, from 0 to 1
+     */
+    static QGradientStops gradientStops(Gradient gradient);
+
+    /**
+     * @brief Get a text color which is readable on top of the end of a gradient
+     */
+    static QColor contrastTextColor(Gradient gradient);
+
+    /**
+     * @brief Get a gradient rendered on top of a checkerboard
+     * @param gradient The gradient to render
+     * @param size Size of the image
+     * @param orientation Qt::Horizontal to render the gradient from left to right, Qt::Vertical from bottom to top
+     */
+    static QImage gradientImage(Gradient gradient, const QSize& size, Qt::Orientation orientation);
+
+    /**
+     * @brief Get the current generation of the cache
+     * @return A counter which is incremented every time the cache is invalidated
+     */
+    static quint64 generation();
+};
+
+#endif // STYLERESOURCES_H
@@ -0,0 +1,101 @@
+/*
+ * Copyright (c) 2021 Victor Wåhlström
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ * claim that you wrote the original software. If you use this software
+ * in a product, an acknowledgment in the product documentation would be
+ * appreciated but is not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source
+ */
+
+
+#include "swatchpainter_p.h"
+
+#include "color_utils_p.h"
+#include "colorcodec_p.h"
+#include "styleresources_p.h"
+
+// qMax() takes its arguments by reference, which requires a definition before C++17
+constexpr const int SwatchPainter::MinimumSize;
+
+QPoint SwatchPainter::textOrigin(const QFontMetrics& fm, const QRect& text_rect, const QString& text)
+{
+    return QPoint(text_rect.x() + (text_rect.width() - fm.horizontalAdvance(text)) / 2,
+                  text_rect.y() + (text_rect.height() - fm.height()) / 2 + fm.ascent());
+}
+
+QSize SwatchPainter::sizeHint(const QFontMetrics& fm, bool display_alpha)
+{
+    const int text_width = fm.horizontalAdvance(display_alpha ? "#DDDDDDDD" : "#DDDDDD");
+    const int h          = qMax(MinimumSize, fm.height() + TextPadding * 2);
+
+    return QSize(h + Spacing + text_width + TextPadding * 2, h);
+}
+
+QString SwatchPainter::hexText(const QColor& color, bool display_alpha)
+{
+    QChar buffer[ColorCodec::MaxLength];
+    const int length = ColorCodec::format(color, display_alpha ? ColorCodec::HexArgb : ColorCodec::HexRgb, buffer);
+    return QString(buffer, length);
+}
+
+void SwatchPainter::drawSwatch(QPainter& painter, const QRect& swatch_rect, const QColor& color)
+{
+    painter.setClipRect(swatch_rect);
+    drawCheckerboard(painter, swatch_rect, 5);
+    painter.fillRect(swatch_rect, color);
+}
+
+void SwatchPainter::drawTextFrame(QPainter& painter, const QPalette& palette, const QRect& text_rect)
+{
+    painter.setClipRect(text_rect);
+    painter.fillRect(text_rect, palette.base());
+    painter.setPen(palette.mid().color());
+    painter.drawRect(text_rect.adjusted(0, 0, -1, -1));
+}
+
+void SwatchPainter::drawEditCursor(QPainter& painter,
+                                   const QPalette& palette,
+                                   const QFontMetrics& fm,
+                                   const QRect& text_rect,
+                                   const QPoint& origin,
+                                   const QString& text,
+                                   int pos)
+{
+    const QRect cursor_rect(origin.x() + fm.horizontalAdvance(text.left(pos)),
+                            text_rect.y() + TextPadding,
+                            fm.horizontalAdvance(text.at(pos)),
+                            text_rect.height() - TextPadding * 2);
+
+    painter.fillRect(cursor_rect, palette.highlight());
+    painter.setPen(palette.highlightedText().color());
+    painter.drawText(QPoint(cursor_rect.x(), origin.y()), QString(text.at(pos)));
+}
+
+void SwatchPainter::draw(QPainter& painter,
+                         const QPalette& palette,
+                         const QRect& bounds,
+                         const QColor& color,
+                         bool display_alpha)
+{
+    const QRect text_rect = textRect(bounds);
+    const QString text    = hexText(color, display_alpha);
+
+    drawSwatch(painter, swatchRect(bounds), color);
+    drawTextFrame(painter, palette, text_rect);
+
+    painter.setPen(palette.text().color());
+    painter.drawText(textOrigin(StyleResources::fontMetrics(painter.font()), text_rect, text), text);
+}
@@ -0,0 +1,114 @@
+/*
+ * Copyright (c) 2021 Victor Wåhlström
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ * claim that you wrote the original software. If you use this software
+ * in a product, an acknowledgment in the product documentation would be
+ * appreciated but is not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source
+ */
+
+
+#ifndef SWATCHPAINTER_H
+#define SWATCHPAINTER_H
+
+#include <QColor>
+#include <QFontMetrics>
+#include <QPainter>
+#include <QPalette>
+
+/**
+ * @brief Drawing code shared by all widgets which display a color swatch next to its hex value
+ *
+ * The swatch is a square at the left end of the bounds, and the hex value is drawn in a framed box filling the rest.
+ */
+class SwatchPainter
+{
+  public:
+    /**
+     * @brief Smallest size of the swatch
+     */
+    static constexpr const int MinimumSize = 15;
+
+    /**
+     * @brief Space between the swatch and the text box
+     */
+    static constexpr const int Spacing = 4;
+
+    /**
+     * @brief Space between the text and the frame of the text box
+     */
+    static constexpr const int TextPadding = 3;
+
+    /**
+     * @brief The swatch within the given bounds
+     */
+    static QRect swatchRect(const QRect& bounds)
+    {
+        return QRect(bounds.x(), bounds.y(), bounds.height(), bounds.height());
+    }
+
+    /**
+     * @brief The text box within the given bounds
+     */
+    static QRect textRect(const QRect& bounds) { return bounds.adjusted(bounds.height() + Spacing, 0, 0, 0); }
+
+    /**
+     * @brief Baseline origin of text centered in the text box
+     */
+    static QPoint textOrigin(const QFontMetrics& fm, const QRect& text_rect, const QString& text);
+
+    /**
+     * @brief Preferred size of a swatch and its hex value
+     */
+    static QSize sizeHint(const QFontMetrics& fm, bool display_alpha);
+
+    /**
+     * @brief The hex value of a color, including the leading '#'
+     */
+    static QString hexText(const QColor& color, bool display_alpha);
+
+    /**
+     * @brief Draw a color over a checkerboard, which shows through translucent colors
+     */
+    static void drawSwatch(QPainter& painter, const QRect& swatch_rect, const QColor& color);
+
+    /**
+     * @brief Draw the background and frame of the text box
+     */
+    static void drawTextFrame(QPainter& painter, const QPalette& palette, const QRect& text_rect);
+
+    /**
+     * @brief Highlight the character at pos, the way QLineEdit does with an input mask
+     */
+    static void drawEditCursor(QPainter& painter,
+                               const QPalette& palette,
+                               const QFontMetrics& fm,
+                               const QRect& text_rect,
+                               const QPoint& origin,
+                               const QString& text,
+                               int pos);
+
+    /**
+     * @brief Draw the swatch and hex value of a color which is not being edited, using the current font
+     */
+    static void draw(QPainter& painter,
+                     const QPalette& palette,
+                     const QRect& bounds,
+                     const QColor& color,
+                     bool display_alpha);
+};
+
+#endif // SWATCHPAINTER_H
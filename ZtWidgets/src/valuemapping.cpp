@@ -0,0 +1,134 @@
+/*
+ * Copyright (c) 2021 Victor Wåhlström
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ * claim that you wrote the original software. If you use this software
+ * in a product, an acknowledgment in the product documentation would be
+ * appreciated but is not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source
+ */
+
+
+#include "valuemapping_p.h"
+
+// makes the sampled values non-decreasing and keeps them within [0, 1], as required by the binary search
+static void makeMonotonic(QVector<qreal>& curve)
+{
+    qreal previous = 0;
+    for (qreal& value : curve)
+    {
+        value    = qBound(previous, value, qreal(1));
+        previous = value;
+    }
+}
+
+QVector<qreal> ValueMapper::sampleCurve(const QVector<QPointF>& points, int samples)
+{
+    QVector<QPointF> p = points;
+    std::sort(p.begin(), p.end(), [](const QPointF& a, const QPointF& b) { return a.x() < b.x(); });
+
+    // the spline is only defined for strictly increasing positions
+    auto last = std::unique(p.begin(),
+                            p.end(),
+                            [](const QPointF& a, const QPointF& b) { return qFuzzyCompare(a.x() + 1, b.x() + 1); });
+    p.erase(last, p.end());
+
+    if (p.size() < 2)
+        return linearCurve();
+
+    // Fritsch-Carlson tangents
+    const int n = p.size();
+    QVector<qreal> slopes(n - 1);
+    QVector<qreal> tangents(n);
+    for (int i = 0; i < n - 1; ++i)
+        slopes[i] = (p[i + 1].y() - p[i].y()) / (p[i + 1].x() - p[i].x());
+
+    tangents[0]     = slopes[0];
+    tangents[n - 1] = slopes[n - 2];
+    for (int i = 1; i < n - 1; ++i)
+        tangents[i] = slopes[i - 1] * slopes[i] > 0 ? (slopes[i - 1] + slopes[i]) * 0.5 : 0;
+
+    for (int i = 0; i < n - 1; ++i)
+    {
+        if (slopes[i] == 0)
+        {
+            tangents[i]     = 0;
+            tangents[i + 1] = 0;
+            continue;
+        }
+
+        const qreal a   = tangents[i] / slopes[i];
+        const qreal b   = tangents[i + 1] / slopes[i];
+        const qreal len = a * a + b * b;
+        if (len > 9)
+        {
+            const qreal tau = 3 / qSqrt(len);
+            tangents[i]     = tau * a * slopes[i];
+            tangents[i + 1] = tau * b * slopes[i];
+        }
+    }
+
+    samples = qMax(samples, 2);
+    QVector<qreal> curve(samples);
+
+    int segment = 0;
+    for (int s = 0; s < samples; ++s)
+    {
+        const qreal x = static_cast<qreal>(s) / (samples - 1);
+        if (x <= p.first().x())
+        {
+            curve[s] = p.first().y();
+            continue;
+        }
+        if (x >= p.last().x())
+        {
+            curve[s] = p.last().y();
+            continue;
+        }
+
+        // sample positions are increasing, so the segment only ever moves forward
+        while (x > p[segment + 1].x())
+            ++segment;
+
+        const qreal h   = p[segment + 1].x() - p[segment].x();
+        const qreal t   = (x - p[segment].x()) / h;
+        const qreal t2  = t * t;
+        const qreal t3  = t2 * t;
+        const qreal h00 = 2 * t3 - 3 * t2 + 1;
+        const qreal h10 = t3 - 2 * t2 + t;
+        const qreal h01 = -2 * t3 + 3 * t2;
+        const qreal h11 = t3 - t2;
+
+        curve[s] = h00 * p[segment].y() + h10 * h * tangents[segment] + h01 * p[segment + 1].y() +
+                   h11 * h * tangents[segment + 1];
+    }
+
+    makeMonotonic(curve);
+    return curve;
+}
+
+QVector<qreal> ValueMapper::sampleCurve(const std::function<qreal(qreal)>& curve, int samples)
+{
+    if (!curve)
+        return linearCurve();
+
+    samples = qMax(samples, 2);
+    QVector<qreal> table(samples);
+    for (int s = 0; s < samples; ++s)
+        table[s] = curve(static_cast<qreal>(s) / (samples - 1));
+
+    makeMonotonic(table);
+    return table;
+}
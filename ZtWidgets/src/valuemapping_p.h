@@ -0,0 +1,403 @@
+/*
+ * Copyright (c) 2021 Victor Wåhlström
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ * claim that you wrote the original software. If you use this software
+ * in a product, an acknowledgment in the product documentation would be
+ * appreciated but is not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source
+ */
+
+
+#ifndef VALUEMAPPING_H
+#define VALUEMAPPING_H
+
+#include <ZtWidgets/slideredit.h>
+
+#include <QPointF>
+#include <QVector>
+#include <QtMath>
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+
+/**
+ * @brief Coefficients of a value mapping, computed once whenever the range or mapping changes
+ *
+ * The meaning of a, b, c and d depends on the mapping. table and last are only used by custom curves.
+ */
+struct ValueMappingCoefficients
+{
+    qreal min;
+    qreal max;
+    qreal a;
+    qreal b;
+    qreal c;
+    qreal d;
+    const qreal* table;
+    int last;
+};
+
+/**
+ * @brief Value mapping policies
+ *
+ * Each policy maps values in [min, max] to a unit position in [0, 1] and back. prepare() computes everything which
+ * only depends on the range, including guards against empty ranges, so that toUnit() and fromUnit() are short,
+ * branch-free expressions. The exceptions are custom curves, which search their table, and the bottom of the decibel
+ * scale, which is a conditional select.
+ */
+namespace ValueMappingPolicy
+{
+    /**
+     * @brief Linear scale. a = 1 / (max - min), b = max - min
+     */
+    struct Linear
+    {
+        static void prepare(ValueMappingCoefficients& k, qreal)
+        {
+            k.b = k.max - k.min;
+            k.a = k.b != 0 ? 1 / k.b : 0;
+        }
+
+        static qreal toUnit(const ValueMappingCoefficients& k, qreal value) { return (value - k.min) * k.a; }
+        static qreal fromUnit(const ValueMappingCoefficients& k, qreal t) { return k.min + t * k.b; }
+    };
+
+    /**
+     * @brief Natural logarithm scale, offset to handle ranges starting below 1. a = offset, b = ln(min + offset),
+     * c = ln(max + offset) - b, d = 1 / c
+     */
+    struct Logarithmic
+    {
+        static void prepare(ValueMappingCoefficients& k, qreal)
+        {
+            k.a = k.min < 1 ? 1 - k.min : 0;
+            k.b = qLn(k.min + k.a);
+            k.c = qLn(k.max + k.a) - k.b;
+            k.d = k.c != 0 ? 1 / k.c : 0;
+        }
+
+        static qreal toUnit(const ValueMappingCoefficients& k, qreal value) { return (qLn(value + k.a) - k.b) * k.d; }
+
+        static qreal fromUnit(const ValueMappingCoefficients& k, qreal t) { return qExp(k.b + t * k.c) - k.a; }
+    };
+
+    /**
+     * @brief Power (gamma) scale, value = min + (max - min) * t^exponent. a = 1 / (max - min), b = max - min,
+     * c = exponent
+     */
+    struct Power
+    {
+        static void prepare(ValueMappingCoefficients& k, qreal exponent)
+        {
+            Linear::prepare(k, exponent);
+            k.c = exponent > 0 ? exponent : 1;
+        }
+
+        static qreal toUnit(const ValueMappingCoefficients& k, qreal value)
+        {
+            return qPow(qMax<qreal>(0, Linear::toUnit(k, value)), 1 / k.c);
+        }
+
+        static qreal fromUnit(const ValueMappingCoefficients& k, qreal t) { return k.min + qPow(t, k.c) * k.b; }
+    };
+
+    /**
+     * @brief Square root scale, the position is proportional to the square root of the value. Same coefficients as
+     * Linear.
+     */
+    struct SquareRoot
+    {
+        static void prepare(ValueMappingCoefficients& k, qreal exponent) { Linear::prepare(k, exponent); }
+
+        static qreal toUnit(const ValueMappingCoefficients& k, qreal value)
+        {
+            return qSqrt(qMax<qreal>(0, Linear::toUnit(k, value)));
+        }
+
+        static qreal fromUnit(const ValueMappingCoefficients& k, qreal t) { return k.min + t * t * k.b; }
+    };
+
+    /**
+     * @brief Symmetric logarithm, sign(v) * ln(1 + |v|), for ranges crossing zero. Linear close to zero and
+     * logarithmic further out in both directions. a = f(min), b = 1 / (f(max) - f(min)), c = f(max) - f(min)
+     */
+    struct SymmetricLog
+    {
+        static qreal forward(qreal value) { return std::copysign(std::log1p(qAbs(value)), value); }
+        static qreal inverse(qreal y) { return std::copysign(std::expm1(qAbs(y)), y); }
+
+        static void prepare(ValueMappingCoefficients& k, qreal)
+        {
+            k.a = forward(k.min);
+            k.c = forward(k.max) - k.a;
+            k.b = k.c != 0 ? 1 / k.c : 0;
+        }
+
+        static qreal toUnit(const ValueMappingCoefficients& k, qreal value) { return (forward(value) - k.a) * k.b; }
+        static qreal fromUnit(const ValueMappingCoefficients& k, qreal t) { return inverse(k.a + t * k.c); }
+    };
+
+    /**
+     * @brief Decibel scale for linear amplitudes, the position is proportional to 20 * log10(value). Values at or
+     * below -120 dB are treated as -120 dB. a = dB(min), b = 1 / (dB(max) - dB(min)), c = dB(max) - dB(min)
+     */
+    struct Decibel
+    {
+        static constexpr qreal floor() { return 1e-6; }
+        static qreal forward(qreal value) { return 20 * std::log10(qMax(value, floor())); }
+        static qreal inverse(qreal db) { return qPow(10, db / 20); }
+
+        static void prepare(ValueMappingCoefficients& k, qreal)
+        {
+            k.a = forward(k.min);
+            k.c = forward(k.max) - k.a;
+            k.b = k.c != 0 ? 1 / k.c : 0;
+        }
+
+        static qreal toUnit(const ValueMappingCoefficients& k, qreal value) { return (forward(value) - k.a) * k.b; }
+
+        static qreal fromUnit(const ValueMappingCoefficients& k, qreal t)
+        {
+            // the bottom of the slider is the minimum, even if it lies below the decibel floor
+            return t > 0 ? inverse(k.a + t * k.c) : k.min;
+        }
+    };
+
+    /**
+     * @brief A custom curve, sampled into a table of unit values at evenly spaced unit positions. a = 1 / (max - min),
+     * b = max - min, table = samples, last = index of the last sample
+     *
+     * fromUnit() interpolates between two neighboring samples in constant time. toUnit() finds them with a binary
+     * search, which requires the samples to be non-decreasing.
+     */
+    struct Custom
+    {
+        static void prepare(ValueMappingCoefficients& k, qreal exponent) { Linear::prepare(k, exponent); }
+
+        static qreal toUnit(const ValueMappingCoefficients& k, qreal value)
+        {
+            const qreal u      = (value - k.min) * k.a;
+            const qreal* first = k.table;
+            const qreal* end   = k.table + k.last + 1;
+            const qreal* it    = std::lower_bound(first, end, u);
+            if (it == first)
+                return 0;
+            if (it == end)
+                return 1;
+
+            const qreal lo = *(it - 1);
+            const qreal hi = *it;
+            const qreal f  = hi > lo ? (u - lo) / (hi - lo) : 0;
+            return ((it - first) - 1 + f) / k.last;
+        }
+
+        static qreal fromUnit(const ValueMappingCoefficients& k, qreal t)
+        {
+            const qreal x = qBound<qreal>(0, t, 1) * k.last;
+            const int i   = qMin(static_cast<int>(x), k.last - 1);
+            const qreal u = k.table[i] + (k.table[i + 1] - k.table[i]) * (x - i);
+            return k.min + u * k.b;
+        }
+    };
+} // namespace ValueMappingPolicy
+
+/**
+ * @brief Maps values to and from positions along a slider
+ *
+ * The mapping is selected in configure(). Each operation switches on it once and then runs code instantiated for the
+ * policy, in which the policy is inlined. Mapping a single value costs one well predicted branch. Operations which map
+ * many values implement a functor with a template<typename Policy> apply() member, and pass it to dispatch() so that
+ * the branch is taken once for all of them.
+ */
+class ValueMapper
+{
+    Q_DISABLE_COPY(ValueMapper)
+
+  public:
+    ValueMapper()
+        : m_Curve(linearCurve())
+    {
+        configure(SliderEdit::LinearScale, 0, 1, 2);
+    }
+
+    /**
+     * @brief Sample control points into a curve table
+     * @param points Control points on the form (unit position, unit value). Values should be non-decreasing.
+     * @param samples Number of samples
+     * @return Non-decreasing unit values at evenly spaced unit positions
+     *
+     * The points are interpolated using a monotone cubic spline (Fritsch-Carlson), which never overshoots between
+     * control points.
+     */
+    static QVector<qreal> sampleCurve(const QVector<QPointF>& points, int samples);
+
+    /**
+     * @brief Sample a function into a curve table
+     * @param curve Function mapping a unit position to a unit value. Should be non-decreasing.
+     * @param samples Number of samples
+     * @return Non-decreasing unit values at evenly spaced unit positions
+     */
+    static QVector<qreal> sampleCurve(const std::function<qreal(qreal)>& curve, int samples);
+
+    /**
+     * @brief Set the curve used by SliderEdit::CustomScale
+     * @param curve A table returned by sampleCurve()
+     *
+     * @note configure() must be called for the change to take effect
+     */
+    void setCurve(const QVector<qreal>& curve) { m_Curve = curve.size() >= 2 ? curve : linearCurve(); }
+
+    /**
+     * @brief Select a mapping and compute its coefficients
+     * @param mapping The mapping to use
+     * @param min Minimum value
+     * @param max Maximum value
+     * @param exponent Exponent used by SliderEdit::PowerScale
+     */
+    void configure(SliderEdit::ValueMapping mapping, qreal min, qreal max, qreal exponent)
+    {
+        m_Mapping          = mapping;
+        m_Coefficients     = ValueMappingCoefficients();
+        m_Coefficients.min = min;
+        m_Coefficients.max = max;
+
+        if (mapping == SliderEdit::CustomScale)
+        {
+            m_Coefficients.table = m_Curve.constData();
+            m_Coefficients.last  = m_Curve.size() - 1;
+        }
+
+        Prepare prepare = {exponent};
+        select(mapping, m_Coefficients, prepare);
+    }
+
+    /**
+     * @brief Run an operation instantiated for the selected policy
+     * @param operation A functor with a member template<typename Policy> void apply(const ValueMappingCoefficients&)
+     */
+    template<typename Operation>
+    void dispatch(Operation& operation) const
+    {
+        select(m_Mapping, m_Coefficients, operation);
+    }
+
+    /**
+     * @brief Map a value to a unit position in [0, 1]
+     */
+    qreal toUnit(qreal value) const
+    {
+        ToUnit operation = {value, 0.0};
+        dispatch(operation);
+        return operation.result;
+    }
+
+    /**
+     * @brief Map a unit position in [0, 1] to a value
+     */
+    qreal fromUnit(qreal t) const
+    {
+        FromUnit operation = {t, 0.0};
+        dispatch(operation);
+        return operation.result;
+    }
+
+    /**
+     * @brief Map a value to a position between min_pos and max_pos
+     */
+    qreal toPosition(qreal value, qreal min_pos, qreal max_pos) const
+    {
+        return min_pos + toUnit(value) * (max_pos - min_pos);
+    }
+
+    /**
+     * @brief Map a position between min_pos and max_pos to a value
+     */
+    qreal fromPosition(qreal pos, qreal min_pos, qreal max_pos) const
+    {
+        return max_pos != min_pos ? fromUnit((pos - min_pos) / (max_pos - min_pos)) : m_Coefficients.min;
+    }
+
+  private:
+    // the coefficients are const, except when they are prepared
+    template<typename Coefficients, typename Operation>
+    static void select(SliderEdit::ValueMapping mapping, Coefficients& k, Operation& operation)
+    {
+        switch (mapping)
+        {
+            case SliderEdit::LinearScale:
+                operation.template apply<ValueMappingPolicy::Linear>(k);
+                break;
+            case SliderEdit::LogarithmicScale:
+                operation.template apply<ValueMappingPolicy::Logarithmic>(k);
+                break;
+            case SliderEdit::PowerScale:
+                operation.template apply<ValueMappingPolicy::Power>(k);
+                break;
+            case SliderEdit::SquareRootScale:
+                operation.template apply<ValueMappingPolicy::SquareRoot>(k);
+                break;
+            case SliderEdit::SymmetricLogScale:
+                operation.template apply<ValueMappingPolicy::SymmetricLog>(k);
+                break;
+            case SliderEdit::DecibelScale:
+                operation.template apply<ValueMappingPolicy::Decibel>(k);
+                break;
+            case SliderEdit::CustomScale:
+                operation.template apply<ValueMappingPolicy::Custom>(k);
+                break;
+        }
+    }
+
+    struct Prepare
+    {
+        qreal exponent;
+
+        template<typename Policy>
+        void apply(ValueMappingCoefficients& k) { Policy::prepare(k, exponent); }
+    };
+
+    struct ToUnit
+    {
+        qreal value;
+        qreal result;
+
+        template<typename Policy>
+        void apply(const ValueMappingCoefficients& k) { result = Policy::toUnit(k, value); }
+    };
+
+    struct FromUnit
+    {
+        qreal t;
+        qreal result;
+
+        template<typename Policy>
+        void apply(const ValueMappingCoefficients& k) { result = Policy::fromUnit(k, t); }
+    };
+
+    static QVector<qreal> linearCurve()
+    {
+        // shared by every mapper, rather than allocated by each of them
+        static const QVector<qreal> s_Linear = QVector<qreal>() << 0.0 << 1.0;
+        return s_Linear;
+    }
+
+    QVector<qreal> m_Curve;
+    ValueMappingCoefficients m_Coefficients;
+    SliderEdit::ValueMapping m_Mapping;
+};
+
+#endif // VALUEMAPPING_H
@@ -23,6 +23,7 @@ misrepresented as being the original software.
 
 from PyQt5.QtWidgets import QMainWindow
 from PyQt5 import uic
+from ZtWidgets.colormodel import ColorModel
 import os
 
 
@@ -44,13 +45,12 @@ class MainWindow(QMainWindow):
             palette.setColor(self.label.foregroundRole(), color)
             self.label.setPalette(palette)
 
-        self.colorPickerArgb.colorChanging.connect(set_label_color)
-        self.colorPickerArgb.colorChanged.connect(set_label_color)
+        # both pickers share a single model, which keeps them in sync
+        self.colorModel = ColorModel(self)
+        self.colorPickerArgb.setModel(self.colorModel)
+        self.colorPickerRgb.setModel(self.colorModel)
 
-        self.colorPickerRgb.colorChanging.connect(set_label_color)
-        self.colorPickerRgb.colorChanged.connect(set_label_color)
-
-        self.colorPickerArgb.colorChanged.connect(self.colorPickerRgb.updateColor)
-        self.colorPickerRgb.colorChanged.connect(self.colorPickerArgb.updateColor)
+        self.colorModel.colorChanging.connect(set_label_color)
+        self.colorModel.colorChanged.connect(set_label_color)
 
         self.show()
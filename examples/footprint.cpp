@@ -0,0 +1,103 @@
+/*
+ * Copyright (c) 2021 Victor Wåhlström
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ * claim that you wrote the original software. If you use this software
+ * in a product, an acknowledgment in the product documentation would be
+ * appreciated but is not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source
+ */
+
+// Measures the heap used by each SliderEdit, e.g. to compare builds before and after a change to SliderEditPrivate.
+//
+//     ZtWidgetsFootprint [count] -platform offscreen
+//
+// The numbers depend on the platform, the Qt build and the C library, so only compare runs made in the same
+// environment. Heap usage is read from glibc; other C libraries report nothing.
+
+#include <ZtWidgets/slideredit.h>
+
+#include <QApplication>
+#include <QWidget>
+
+#include <cstdio>
+
+#if defined(__GLIBC__) && (__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 33))
+#include <malloc.h>
+#define FOOTPRINT_HAS_MALLINFO2
+#endif
+
+static size_t heapInUse()
+{
+#ifdef FOOTPRINT_HAS_MALLINFO2
+    return mallinfo2().uordblks;
+#else
+    return 0;
+#endif
+}
+
+static SliderEdit* createSlider(QWidget* parent, int index)
+{
+    static const int s_Columns = 20;
+
+    SliderEdit* slider = new SliderEdit(parent);
+    slider->setGeometry((index % s_Columns) * 120, (index / s_Columns) * 20, 120, 20);
+    slider->setRange(-60.0, 12.0);
+    slider->setLabel(QStringLiteral("Gain"));
+    slider->setUnit(QStringLiteral("dB"));
+    slider->setValue(index % 72 - 60.0);
+    return slider;
+}
+
+int main(int argc, char* argv[])
+{
+    QApplication a(argc, argv);
+
+    const QStringList args = a.arguments();
+    const int count        = args.size() > 1 ? qMax(1, args.at(1).toInt()) : 1000;
+
+    QWidget panel;
+    panel.resize(20 * 120, (count / 20 + 2) * 20);
+
+    // the first slider creates the resources shared by all of them, which are not counted
+    createSlider(&panel, 0);
+    panel.show();
+    a.processEvents();
+
+    const size_t start = heapInUse();
+    for (int i = 1; i <= count; ++i)
+        createSlider(&panel, i);
+
+    const size_t created = heapInUse();
+
+    // painting creates the cached display text of each slider
+    panel.update();
+    a.processEvents();
+
+    const size_t painted = heapInUse();
+
+#ifdef FOOTPRINT_HAS_MALLINFO2
+    std::printf("%d sliders\n", count);
+    std::printf("created: %.1f bytes of heap per slider\n", double(created - start) / count);
+    std::printf("painted: %.1f bytes of heap per slider\n", double(painted - start) / count);
+#else
+    Q_UNUSED(start)
+    Q_UNUSED(created)
+    Q_UNUSED(painted)
+    std::printf("heap usage is only reported with glibc 2.33 or later\n");
+#endif
+
+    return 0;
+}
@@ -26,6 +26,7 @@
 #include <QtWidgets/QLayout>
 #include <QtWidgets/QLineEdit>
 
+#include <ZtWidgets/colormodel.h>
 #include <ZtWidgets/colorpicker.h>
 
 MainWindow::MainWindow(QWidget* parent)
@@ -40,14 +41,13 @@ MainWindow::MainWindow(QWidget* parent)
         ui->label->setPalette(palette);
     };
 
-    connect(ui->colorPickerArgb, &ColorPicker::colorChanging, this, set_label_color);
-    connect(ui->colorPickerArgb, &ColorPicker::colorChanged, this, set_label_color);
+    // both pickers share a single model, which keeps them in sync
+    ColorModel* color_model = new ColorModel(this);
+    ui->colorPickerArgb->setModel(color_model);
+    ui->colorPickerRgb->setModel(color_model);
 
-    connect(ui->colorPickerRgb, &ColorPicker::colorChanging, this, set_label_color);
-    connect(ui->colorPickerRgb, &ColorPicker::colorChanged, this, set_label_color);
-
-    connect(ui->colorPickerArgb, &ColorPicker::colorChanged, ui->colorPickerRgb, &ColorPicker::updateColor);
-    connect(ui->colorPickerRgb, &ColorPicker::colorChanged, ui->colorPickerArgb, &ColorPicker::updateColor);
+    connect(color_model, &ColorModel::colorChanging, this, set_label_color);
+    connect(color_model, &ColorModel::colorChanged, this, set_label_color);
 
     show();
 }